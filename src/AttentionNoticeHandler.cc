@@ -24,31 +24,49 @@
 #include "Window.hh"
 #include "Screen.hh"
 
-#include "FbTk/STLUtil.hh"
-#include "FbTk/Timer.hh"
+#include "FbTk/SimpleCommand.hh"
 #include "FbTk/Resource.hh"
 #include "FbTk/MemFun.hh"
 
 namespace {
-class ToggleFrameFocusCmd: public FbTk::Command<void> {
-public:
-    ToggleFrameFocusCmd(Focusable &client):
-        m_client(client),
-        m_state(false) {}
-    void execute() {
-        m_state ^= true;
-        m_client.setAttentionState(m_state);
-    }
-private:
-    Focusable &m_client;
-    bool m_state;
-};
+
+/// whether flashing win would show anywhere, in the frame or an iconbar
+bool isShown(Focusable &win) {
+    FluxboxWindow *fbwin = win.fbwindow();
+    return fbwin && (fbwin->isVisible() || fbwin->isIconic() || fbwin->isStuck());
+}
 
 } // end anonymous namespace 
 
+AttentionNoticeHandler::AttentionNoticeHandler():
+    m_blink_state(false) {
+
+    FbTk::RefCount<FbTk::Command<void> > cmd(new FbTk::SimpleCommand<AttentionNoticeHandler>(*this, &AttentionNoticeHandler::blink));
+    m_blink_timer.setCommand(cmd);
+    m_blink_timer.fireOnce(false); // will repeat until all windows have focus
+}
 
 AttentionNoticeHandler::~AttentionNoticeHandler() {
-    FbTk::STLUtil::destroyAndClearSecond(m_attentions);
+    m_blink_timer.stop();
+}
+
+int AttentionNoticeHandler::blinkTimeout(BScreen &screen) {
+    using namespace FbTk;
+
+    Resource<int> *&timeout_res = m_timeouts[&screen];
+    if (timeout_res != 0)
+        return **timeout_res;
+
+    ResourceManager &res = screen.resourceManager();
+    std::string res_name = screen.name() + ".demandsAttentionTimeout";
+    std::string res_alt_name = screen.name() + ".DemandsAttentionTimeout";
+    timeout_res = dynamic_cast<Resource<int>* >(res.findResource(res_name));
+    if (timeout_res == 0) {
+        // no resource, create one and add it to managed resources
+        timeout_res = new FbTk::Resource<int>(res, 500, res_name, res_alt_name);
+        screen.addManagedResource(timeout_res);
+    }
+    return **timeout_res;
 }
 
 void AttentionNoticeHandler::addAttention(Focusable &client) {
@@ -57,38 +75,36 @@ void AttentionNoticeHandler::addAttention(Focusable &client) {
         return;
 
     // Already have a notice for it?
-    NoticeMap::iterator it = m_attentions.find(&client);
-    if (it != m_attentions.end()) {
+    if (m_attentions.find(&client) != m_attentions.end())
         return; 
-    }
 
     using namespace FbTk;
 
-    ResourceManager &res = client.screen().resourceManager();
-    std::string res_name = client.screen().name() + ".demandsAttentionTimeout";
-    std::string res_alt_name = client.screen().name() + ".DemandsAttentionTimeout";
-    Resource<int> *timeout_res = dynamic_cast<Resource<int>* >(res.findResource(res_name));
-    if (timeout_res == 0) {
-        // no resource, create one and add it to managed resources
-        timeout_res = new FbTk::Resource<int>(res, 500, res_name, res_alt_name);
-        client.screen().addManagedResource(timeout_res);
-    }
     // disable if timeout is zero
-    if (**timeout_res == 0) 
+    int timeout = blinkTimeout(client.screen());
+    if (timeout == 0) 
         return;
 
-    // setup timer
-    RefCount<Command<void> > cmd(new ToggleFrameFocusCmd(client));
-    Timer *timer = new Timer();
-    timer->setCommand(cmd);
-    timer->setTimeout(**timeout_res * FbTk::FbTime::IN_MILLISECONDS);
-    timer->fireOnce(false); // will repeat until window has focus
-    timer->start();
+    m_attentions.insert(&client);
+    // the first notice sets the pace, later ones join its phase
+    if (m_attentions.size() == 1) {
+        m_blink_state = false;
+        m_blink_timer.setTimeout(timeout * FbTk::FbTime::IN_MILLISECONDS);
+    }
+    resume();
 
-    m_attentions[&client] = timer; 
     // attach signals that will make notice go away
     join(client.dieSig(), MemFun(*this, &AttentionNoticeHandler::removeWindow));
     join(client.focusSig(), MemFun(*this, &AttentionNoticeHandler::windowFocusChanged));
+    // and the ones that might make it visible again
+    join(client.screen().currentWorkspaceSig(),
+         MemFunIgnoreArgs(*this, &AttentionNoticeHandler::resume));
+    if (client.fbwindow()) {
+        join(client.fbwindow()->stateSig(),
+             MemFunIgnoreArgs(*this, &AttentionNoticeHandler::resume));
+        join(client.fbwindow()->workspaceSig(),
+             MemFunIgnoreArgs(*this, &AttentionNoticeHandler::resume));
+    }
 
     // update _NET_WM_STATE atom
     if (client.fbwindow())
@@ -105,22 +121,59 @@ void AttentionNoticeHandler::removeWindow(Focusable& win) {
 void AttentionNoticeHandler::updateWindow(Focusable& win, bool died) {
     // all signals results in destruction of the notice
 
-    delete m_attentions[&win];
-    m_attentions.erase(&win);
+    if (m_attentions.erase(&win) == 0)
+        return;
+
+    leave(win.dieSig());
+    leave(win.focusSig());
+    FluxboxWindow *fbwin = win.fbwindow();
+    if (fbwin && !died) {
+        // tabs share these, keep listening while one of them is still in
+        bool tab_left = false;
+        NoticeMap::iterator it = m_attentions.begin(), it_end = m_attentions.end();
+        for (; it != it_end && !tab_left; ++it)
+            tab_left = (*it)->fbwindow() == fbwin;
+        if (!tab_left) {
+            leave(fbwin->stateSig());
+            leave(fbwin->workspaceSig());
+        }
+    }
+    if (m_attentions.empty())
+        m_blink_timer.stop();
+
     win.setAttentionState(false);
 
     // update _NET_WM_STATE atom if the window is not dead
-    FluxboxWindow *fbwin = win.fbwindow();
     if (fbwin && ! died)
         fbwin->stateSig().emit(*fbwin);
 
 }
 
-bool AttentionNoticeHandler::isDemandingAttention(const Focusable &client) {
-    NoticeMap::iterator it = m_attentions.begin(), it_end = m_attentions.end();
+void AttentionNoticeHandler::blink() {
+    m_blink_state ^= true;
+
+    bool shown = false;
+    // copy, a state change might end up in removing a notice
+    NoticeMap notices(m_attentions);
+    NoticeMap::iterator it = notices.begin(), it_end = notices.end();
     for (; it != it_end; ++it) {
-        if (it->first == &client)
-            return true;
+        if (m_attentions.find(*it) == m_attentions.end() || !isShown(**it))
+            continue;
+        shown = true;
+        if ((*it)->getAttentionState() != m_blink_state)
+            (*it)->setAttentionState(m_blink_state);
     }
-    return false;
+
+    // nothing to flash, sleep until a notice might show up again
+    if (!shown)
+        m_blink_timer.stop();
+}
+
+void AttentionNoticeHandler::resume() {
+    if (!m_attentions.empty() && !m_blink_timer.isTiming())
+        m_blink_timer.start();
+}
+
+bool AttentionNoticeHandler::isDemandingAttention(const Focusable &client) {
+    return m_attentions.find(const_cast<Focusable *>(&client)) != m_attentions.end();
 }
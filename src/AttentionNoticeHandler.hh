@@ -23,24 +23,30 @@
 #define ATTENTIONNOTICEHANDLER_HH
 
 #include <map>
+#include <set>
 
 #include "FbTk/Signal.hh"
+#include "FbTk/Timer.hh"
 
+class BScreen;
 class Focusable;
 
 namespace FbTk {
-class Timer;
+template <typename T> class Resource;
 }
+
 /** 
  * Handles demands attention signals.
  * Makes the title and iconbutton flash when the window 
- * demands attention.
+ * demands attention. All windows blink in phase, driven by one clock
+ * which only runs while one of them can be seen.
  */
 class AttentionNoticeHandler: private FbTk::SignalTracker {
 public:
+    AttentionNoticeHandler();
     ~AttentionNoticeHandler();
 
-    typedef std::map<Focusable*, FbTk::Timer*> NoticeMap;
+    typedef std::set<Focusable*> NoticeMap;
     /// Adds a client that requires attention,
     /// will fail if the client is already active
     void addAttention(Focusable &client); 
@@ -55,8 +61,17 @@ public:
 private:
     /// updates the windows state in this instance.
     void updateWindow(Focusable& win, bool died);
+    /// @return the blink interval of screen in milliseconds, 0 if disabled
+    int blinkTimeout(BScreen &screen);
+    /// toggles all visible notices at once
+    void blink();
+    /// starts the clock again after it suspended itself
+    void resume();
 
     NoticeMap m_attentions;
+    FbTk::Timer m_blink_timer;
+    bool m_blink_state; ///< attention state of all notices in this phase
+    std::map<BScreen *, FbTk::Resource<int> *> m_timeouts;
 };
 
 #endif // ATTENTIONNOTICEHANDLER_HH
@@ -32,6 +32,9 @@
 
 #include <X11/keysym.h>
 
+#include <set>
+#include <vector>
+
 namespace { // anonymous
 
 class ClientMenuItem: public FbTk::MenuItem {
@@ -107,61 +110,83 @@ ClientMenu::ClientMenu(BScreen &screen, Focusables &clients,
 }
 
 void ClientMenu::refreshMenu() {
-    // remove all items and then add them again
-    removeAll();
-
-    // for each fluxboxwindow add every client in them to our clientlist
+    // every client of each fluxboxwindow, in menu order
+    std::vector<Focusable *> clients;
     Focusables::iterator win_it = m_list.begin();
     Focusables::iterator win_it_end = m_list.end();
     for (; win_it != win_it_end; ++win_it) {
-        // add every client in this fluxboxwindow to menu
-        if (typeid(*win_it) == typeid(FluxboxWindow *)) {
-            FluxboxWindow *win = static_cast<FluxboxWindow *>(*win_it);
-            FluxboxWindow::ClientList::iterator client_it =
-                win->clientList().begin();
-            FluxboxWindow::ClientList::iterator client_it_end =
-                win->clientList().end();
-            for (; client_it != client_it_end; ++client_it)
-                insertItem(new ClientMenuItem(**client_it, *this));
-        } else
-            insertItem(new ClientMenuItem(**win_it, *this));
+        FluxboxWindow::ClientList::iterator client_it =
+            (*win_it)->clientList().begin();
+        FluxboxWindow::ClientList::iterator client_it_end =
+            (*win_it)->clientList().end();
+        for (; client_it != client_it_end; ++client_it)
+            clients.push_back(*client_it);
     }
 
-    updateMenu();
-}
+    // drop the items of clients that left the list
+    std::set<const Focusable *> listed(clients.begin(), clients.end());
+    ItemIndex::iterator it = m_items_by_client.begin();
+    while (it != m_items_by_client.end()) {
+        if (listed.find(it->first) == listed.end()) {
+            FbTk::Menu::removeItem(it->second);
+            m_items_by_client.erase(it++);
+        } else
+            ++it;
+    }
 
-namespace {
-
-ClientMenuItem* getMenuItem(ClientMenu& menu, Focusable& win) {
-    // find the corresponding menuitem
-    ClientMenuItem *cl_item = 0;
-    for (size_t i = 0; i < menu.numberOfItems(); i++) {
-        FbTk::MenuItem *item = menu.find(i);
-        if (item && typeid(*item) == typeid(ClientMenuItem)) {
-            cl_item = static_cast<ClientMenuItem *>(item);
-            if (cl_item->client() == &win)
-                break;
+    // fix whatever isn't in place, a window moving to another position
+    // costs just its own item
+    for (size_t i = 0; i < clients.size(); ++i) {
+        FbTk::MenuItem *current = i < numberOfItems() ? find(i) : 0;
+        it = m_items_by_client.find(clients[i]);
+        if (it != m_items_by_client.end()) {
+            if (current == it->second)
+                continue;
+
+            if (i + 1 < numberOfItems() && find(i + 1) == it->second) {
+                // the current item moved down, it comes back once we get
+                // to its client
+                m_items_by_client.erase(static_cast<ClientMenuItem *>(current)->client());
+                FbTk::Menu::remove(i);
+                continue;
+            }
+
+            FbTk::Menu::removeItem(it->second);
         }
-    }
 
-    return cl_item;
+        ClientMenuItem *item = new ClientMenuItem(*clients[i], *this);
+        insertItem(item, i);
+        m_items_by_client[clients[i]] = item;
+    }
 
+    // hidden menus are laid out when they are shown
+    if (isVisible())
+        updateMenu();
 }
 
-} // anonymous
+int ClientMenu::itemIndex(const Focusable &win) const {
+    ItemIndex::const_iterator it = m_items_by_client.find(&win);
+    if (it == m_items_by_client.end())
+        return -1;
+
+    for (size_t i = 0; i < numberOfItems(); ++i) {
+        if (find(i) == it->second)
+            return i;
+    }
+    return -1;
+}
 
 void ClientMenu::titleChanged(Focusable& win) {
-    // find correct menu item
-    ClientMenuItem* cl_item = getMenuItem(*this, win);
-    if (cl_item)
-        themeReconfigured();
+    int index = itemIndex(win);
+    if (index >= 0)
+        updateItem(index);
 }
 
 void ClientMenu::clientDied(Focusable &win) {
-    // find correct menu item
-    ClientMenuItem* cl_item = getMenuItem(*this, win);
+    ItemIndex::iterator it = m_items_by_client.find(&win);
+    if (it == m_items_by_client.end())
+        return;
 
-    // update accordingly
-    if (cl_item)
-        FbTk::Menu::removeItem(cl_item);
+    FbTk::Menu::removeItem(it->second);
+    m_items_by_client.erase(it);
 }
@@ -26,6 +26,8 @@
 
 #include "FbTk/Signal.hh"
 
+#include <map>
+
 class BScreen;
 class FluxboxWindow;
 class Focusable;
@@ -47,7 +49,7 @@ public:
     ClientMenu(BScreen &screen, 
                Focusables &clients, bool listen_for_iconlist_changes);
 
-    /// refresh the entire menu
+    /// bring the menu in line with the client list, touches only changed items
     void refreshMenu();
 
     /// Called when window title changed.
@@ -62,7 +64,13 @@ private:
         refreshMenu();
     }
 
+    /// @return position of the item for win, -1 if it isn't in the menu
+    int itemIndex(const Focusable &win) const;
+
+    typedef std::map<const Focusable *, FbTk::MenuItem *> ItemIndex;
+
     Focusables &m_list; ///< clients in the menu
+    ItemIndex m_items_by_client; ///< client -> its menu item
     FbTk::SignalTracker m_slots; ///< track all the slots
 };
 
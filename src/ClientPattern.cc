@@ -358,6 +358,15 @@ bool ClientPattern::dependsOnCurrentWorkspace() const {
     return false;
 }
 
+bool ClientPattern::dependsOn(WinProperty prop) const {
+    Terms::const_iterator it = m_terms.begin(), it_end = m_terms.end();
+    for (; it != it_end; ++it) {
+        if ((*it)->prop == prop)
+            return true;
+    }
+    return false;
+}
+
 // add an expression to match against
 // The first argument is a regular expression, the second is the member
 // function that we wish to match against.
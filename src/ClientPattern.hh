@@ -67,6 +67,9 @@ public:
     /// Does this pattern depend on the current workspace?
     bool dependsOnCurrentWorkspace() const;
 
+    /// Does any term of this pattern look at the given property?
+    bool dependsOn(WinProperty prop) const;
+
     /**
      * Add an expression to match against
      * @param str is a regular expression
@@ -190,6 +190,10 @@ void ClockTool::move(int x, int y) {
 }
 
 void ClockTool::resize(unsigned int width, unsigned int height) {
+    // the toolbar relayouts all items at once, keep our background
+    // layer if the size didn't change
+    if (width == m_button.width() && height == m_button.height())
+        return;
     m_button.resize(width, height);
     reRender();
     m_button.clear();
@@ -197,6 +201,16 @@ void ClockTool::resize(unsigned int width, unsigned int height) {
 
 void ClockTool::moveResize(int x, int y,
                       unsigned int width, unsigned int height) {
+    if (width == m_button.width() && height == m_button.height()) {
+        if (x == m_button.x() && y == m_button.y())
+            return;
+        m_button.move(x, y);
+        // a transparent clock shows another part of the root window now,
+        // move() only updated the background
+        if (m_button.alpha() != 255)
+            m_button.clear();
+        return;
+    }
     m_button.moveResize(x, y, width, height);
     reRender();
     m_button.clear();
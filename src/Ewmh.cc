@@ -340,6 +340,9 @@ public:
         wm_window_type_dialog = XInternAtom(disp, "_NET_WM_WINDOW_TYPE_DIALOG", False);
         wm_window_type_menu = XInternAtom(disp, "_NET_WM_WINDOW_TYPE_MENU", False);
         wm_window_type_toolbar = XInternAtom(disp, "_NET_WM_WINDOW_TYPE_TOOLBAR", False);
+        wm_window_type_utility = XInternAtom(disp, "_NET_WM_WINDOW_TYPE_UTILITY", False);
+        wm_window_type_notification = XInternAtom(disp, "_NET_WM_WINDOW_TYPE_NOTIFICATION", False);
+        wm_window_type_tooltip = XInternAtom(disp, "_NET_WM_WINDOW_TYPE_TOOLTIP", False);
         wm_window_type_normal = XInternAtom(disp, "_NET_WM_WINDOW_TYPE_NORMAL", False);
 
         // state atom and the supported state atoms
@@ -416,6 +419,9 @@ public:
          wm_window_type_dialog,
          wm_window_type_menu,
          wm_window_type_toolbar,
+         wm_window_type_utility,
+         wm_window_type_notification,
+         wm_window_type_tooltip,
          wm_window_type_normal,
 
          // states
@@ -549,6 +555,9 @@ void Ewmh::initForScreen(BScreen &screen) {
         m_net->wm_window_type_dialog,
         m_net->wm_window_type_menu,
         m_net->wm_window_type_toolbar,
+        m_net->wm_window_type_utility,
+        m_net->wm_window_type_notification,
+        m_net->wm_window_type_tooltip,
         m_net->wm_window_type_normal,
 
         // window actions
@@ -669,12 +678,13 @@ void Ewmh::setupClient(WinClient &winclient) {
                 type = WindowState::TYPE_MENU;
             else if (atoms[l] == m_net->wm_window_type_toolbar)
                 type = WindowState::TYPE_TOOLBAR;
+            else if (atoms[l] == m_net->wm_window_type_utility)
+                type = WindowState::TYPE_UTILITY;
+            else if (atoms[l] == m_net->wm_window_type_notification ||
+                     atoms[l] == m_net->wm_window_type_tooltip)
+                type = WindowState::TYPE_NOTIFICATION;
             else if (atoms[l] != m_net->wm_window_type_normal)
                 continue;
-            /*
-             * NOT YET IMPLEMENTED:
-             *   _NET_WM_WINDOW_TYPE_UTILITY
-             */
             break;
         }
         XFree(data);
@@ -947,7 +957,7 @@ void Ewmh::updateWorkarea(BScreen &screen) {
      * Not sure how to handle xinerama stuff here.
      * So i'm just doing this on the first head.
      */
-    unsigned long *coords = new unsigned long[4*screen.numberOfWorkspaces()];
+    vector<unsigned long> coords(4*screen.numberOfWorkspaces());
     for (unsigned int i=0; i < screen.numberOfWorkspaces()*4; i+=4) {
         // x, y
         coords[i] = screen.maxLeft(0);
@@ -957,13 +967,18 @@ void Ewmh::updateWorkarea(BScreen &screen) {
         coords[i + 3] = screen.maxBottom(0) - screen.maxTop(0);
 
     }
+
+    // struts on other heads don't change it, skip writing the same again
+    vector<unsigned long> &current = m_workareas[screen.rootWindow().window()];
+    if (coords == current)
+        return;
+    current.swap(coords);
+
     screen.rootWindow().changeProperty(m_net->workarea,
                                        XA_CARDINAL, 32,
                                        PropModeReplace,
-                                       (unsigned char *)coords,
-                                       4 * screen.numberOfWorkspaces());
-
-    delete[] coords;
+                                       (unsigned char *)&current[0],
+                                       current.size());
 }
 
 void Ewmh::updateState(FluxboxWindow &win) {
@@ -22,6 +22,10 @@
 #include "AtomHandler.hh"
 #include "FbTk/FbString.hh"
 
+#include <X11/Xlib.h>
+#include <map>
+#include <vector>
+
 /// Implementes Extended Window Manager Hints ( http://www.freedesktop.org/Standards/wm-spec )
 class Ewmh:public AtomHandler {
 public:
@@ -74,4 +78,6 @@ private:
 
     class EwmhAtoms;
     EwmhAtoms* m_net;
+    /// last _NET_WORKAREA written, per root window
+    std::map<Window, std::vector<unsigned long> > m_workareas;
 };
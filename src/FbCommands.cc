@@ -29,11 +29,13 @@
 #include "Window.hh"
 #include "Keys.hh"
 #include "MenuCreator.hh"
+#include "Debug.hh"
 
 #include "FbTk/Theme.hh"
 #include "FbTk/Menu.hh"
 #include "FbTk/CommandParser.hh"
 #include "FbTk/StringUtil.hh"
+#include "FbTk/FbTime.hh"
 #include "FbTk/stringstream.hh"
 
 #include <sys/types.h>
@@ -42,6 +44,7 @@
 #include <fstream>
 #include <iostream>
 #include <set>
+#include <vector>
 #include <cstdlib>
 #include <cstring>
 
@@ -49,6 +52,15 @@
 #include <process.h> // for P_NOWAIT
 #endif // __EMX__
 
+#if defined(HAVE_SPAWN_H) && defined(HAVE_POSIX_SPAWN)
+#include <spawn.h>
+// without it the child would stay in our session
+#ifdef POSIX_SPAWN_SETSID
+#define USE_POSIX_SPAWN
+extern char **environ;
+#endif // POSIX_SPAWN_SETSID
+#endif // HAVE_SPAWN_H && HAVE_POSIX_SPAWN
+
 using std::string;
 using std::pair;
 using std::set;
@@ -91,6 +103,74 @@ void showMenu(BScreen &screen, FbTk::Menu &menu) {
     screen.placementStrategy().placeAndShowMenu(menu, x, y, mouseInStrut);
 }
 
+#ifdef USE_POSIX_SPAWN
+
+/**
+ * Splits cmd into its words if it is a plain "program arg ..." line,
+ * anything the shell would have to expand or interpret is left to it.
+ */
+bool splitSimpleCommand(const string &cmd, std::vector<string> &args) {
+    if (cmd.find_first_of("|&;<>()$`\\\"'*?[]{}#~=!\n") != string::npos)
+        return false;
+
+    args.clear();
+    FbTk::StringUtil::stringtok(args, cmd, " \t");
+    return !args.empty();
+}
+
+/**
+ * Starts cmd in a new session with DISPLAY set to display. posix_spawn()
+ * doesn't copy our page tables like fork() does, which matters with all
+ * the pixmaps and fonts a long running fluxbox holds.
+ */
+pid_t spawnCommand(const string &cmd, const string &display) {
+
+    const string display_env = "DISPLAY=" + display;
+    std::vector<char *> env;
+    for (char **e = environ; *e != 0; ++e) {
+        if (strncmp(*e, "DISPLAY=", 8) != 0)
+            env.push_back(*e);
+    }
+    env.push_back(const_cast<char *>(display_env.c_str()));
+    env.push_back(0);
+
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSID);
+
+    pid_t pid = -1;
+    std::vector<string> args;
+    if (splitSimpleCommand(cmd, args)) {
+        std::vector<char *> argv;
+        for (size_t i = 0; i < args.size(); ++i)
+            argv.push_back(const_cast<char *>(args[i].c_str()));
+        argv.push_back(0);
+
+        // could be a shell builtin or a typo, the shell handles (or
+        // reports) those like it always did
+        if (posix_spawnp(&pid, argv[0], 0, &attr, &argv[0], &env[0]) != 0)
+            pid = -1;
+    }
+
+    if (pid == -1) {
+        const char *shell = getenv("SHELL");
+        if (!shell)
+            shell = "/bin/sh";
+
+        char *argv[] = {
+            const_cast<char *>(shell), const_cast<char *>("-c"),
+            const_cast<char *>(cmd.c_str()), 0
+        };
+        if (posix_spawn(&pid, shell, 0, &attr, argv, &env[0]) != 0)
+            pid = -1;
+    }
+
+    posix_spawnattr_destroy(&attr);
+    return pid;
+}
+
+#endif // USE_POSIX_SPAWN
+
 }
 
 namespace FbCommands {
@@ -126,9 +206,7 @@ int ExecuteCmd::run() {
 
     return spawnlp(P_NOWAIT, comspec, comspec, "/c", m_cmd.c_str(), static_cast<void*>(NULL));
 #else
-    pid_t pid = fork();
-    if (pid)
-        return pid;
+    uint64_t start = FbTk::FbTime::mono();
 
     // 'display' is given as 'host:number.screen'. we want to give the
     // new app a good home, so we remove '.screen' from what is given
@@ -152,6 +230,18 @@ int ExecuteCmd::run() {
     display += '.';
     display += FbTk::StringUtil::number2String(screen_num);
 
+    // children are reaped by the SIGCHLD handler in main.cc
+#ifdef USE_POSIX_SPAWN
+    pid_t pid = spawnCommand(m_cmd, display);
+#else
+    pid_t pid = fork();
+#endif // USE_POSIX_SPAWN
+    if (pid) {
+        fbdbg<<"ExecuteCmd: started "<<pid<<" in "
+             <<(FbTk::FbTime::mono() - start)<<"us: "<<m_cmd<<endl;
+        return pid;
+    }
+
     FbTk::App::setenv("DISPLAY", display.c_str());
 
     // get shell path from the environment
@@ -424,6 +424,12 @@ void Container::repositionItems() {
         }
     }
 
+    // compute the whole layout first, then touch only the items whose
+    // geometry actually changed; a window opening or closing at the end
+    // of the iconbar must not reconfigure and repaint every other button
+    std::vector<Geometry> layout;
+    layout.reserve(num_items);
+
     it = begin();
     for (int i = 0; it != it_end; ++it, ++i) {
         // we only need to do error stuff with alignment RELATIVE
@@ -454,11 +460,25 @@ void Container::repositionItems() {
         translatePosition(m_orientation, tmpx, tmpy, tmpw, tmph, borderW);
         translateSize(m_orientation, tmpw, tmph);
 
-        // resize each clients including border in size
-        (*it)->moveResize(tmpx, tmpy,
-                          tmpw, tmph);
+        Geometry geom = { tmpx, tmpy, tmpw, tmph };
+        layout.push_back(geom);
+    }
 
+    // the configure requests end up in one output buffer and are flushed
+    // together by the event loop
+    it = begin();
+    for (size_t i = 0; it != it_end; ++it, ++i) {
+        Item item = *it;
+        const Geometry &geom = layout[i];
+        if (item->width() == geom.width && item->height() == geom.height) {
+            // same size: the rendered background and label stay valid
+            if (item->x() != geom.x || item->y() != geom.y)
+                item->move(geom.x, geom.y);
+            continue;
+        }
+        // resize each clients including border in size
         // moveresize does a clear
+        item->moveResize(geom.x, geom.y, geom.width, geom.height);
     }
 
 }
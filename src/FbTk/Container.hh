@@ -100,6 +100,11 @@ public:
 
     void repositionItems();
 private:
+    /// geometry of an item, as computed by repositionItems
+    struct Geometry {
+        int x, y;
+        unsigned int width, height;
+    };
 
     Orientation m_orientation;
 
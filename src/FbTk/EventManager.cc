@@ -54,7 +54,7 @@ void EventManager::add(EventHandler &ev, const FbWindow &win) {
 
 void EventManager::addParent(EventHandler &ev, const FbWindow &win) {
     if (win.window() != 0)
-        m_parent[win.window()] = &ev;
+        m_eventhandlers[win.window()].parent = &ev;
 }
 
 void EventManager::remove(const FbWindow &win) {
@@ -62,7 +62,8 @@ void EventManager::remove(const FbWindow &win) {
 }
 
 EventHandler *EventManager::find(Window win) {
-    return m_eventhandlers[win];
+    Handlers *handlers = m_eventhandlers.find(win);
+    return handlers ? handlers->handler : 0;
 }
 
 bool EventManager::grabKeyboard(Window win) {
@@ -129,32 +130,24 @@ Window EventManager::getEventWindow(XEvent &ev) {
 
 void EventManager::registerEventHandler(EventHandler &ev, Window win) {
     if (win != None)
-        m_eventhandlers[win] = &ev;
+        m_eventhandlers[win].handler = &ev;
 }
 
 void EventManager::unregisterEventHandler(Window win) {
     if (win != None) {
         m_eventhandlers.erase(win);
-        m_parent.erase(win);
     }
 }
 
 void EventManager::dispatch(Window win, XEvent &ev, bool parent) {
-    EventHandler *evhand = 0;
-    if (parent) {
-        EventHandlerMap::iterator it = m_parent.find(win);
-        if (it == m_parent.end())
-            return;
-        else
-            evhand = it->second;
-    } else {
+    if (!parent)
         win = getEventWindow(ev);
-        EventHandlerMap::iterator it = m_eventhandlers.find(win);
-        if (it == m_eventhandlers.end())
-            return;
-        else
-            evhand = it->second;
-    }
+
+    Handlers *handlers = m_eventhandlers.find(win);
+    if (handlers == 0)
+        return;
+
+    EventHandler *evhand = parent ? handlers->parent : handlers->handler;
 
     if (evhand == 0)
         return;
@@ -203,7 +196,8 @@ void EventManager::dispatch(Window win, XEvent &ev, bool parent) {
 
         if (parent_win != 0 &&
             parent_win != root) {
-            if (m_parent[parent_win] == 0)
+            handlers = m_eventhandlers.find(parent_win);
+            if (handlers == 0 || handlers->parent == 0)
                 return;
 
             // dispatch event to parent
@@ -22,7 +22,8 @@
 #ifndef FBTK_EVENTMANAGER_HH
 #define FBTK_EVENTMANAGER_HH
 
-#include <map>
+#include "XIDTable.hh"
+
 #include <X11/Xlib.h>
 
 namespace FbTk {
@@ -62,9 +63,15 @@ private:
     ~EventManager();
     void dispatch(Window win, XEvent &event, bool parent = false);
 
-    typedef std::map<Window, EventHandler *> EventHandlerMap;
+    /// handlers of a window, so dispatch needs one lookup for both
+    struct Handlers {
+        Handlers(): handler(0), parent(0) { }
+        EventHandler *handler; ///< for events on the window itself
+        EventHandler *parent; ///< for events on children of the window
+    };
+
+    typedef XIDTable<Handlers> EventHandlerMap;
     EventHandlerMap m_eventhandlers;
-    EventHandlerMap m_parent;
 };
 
 } //end namespace FbTk
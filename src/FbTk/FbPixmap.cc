@@ -25,9 +25,13 @@
 #include "Transparent.hh"
 #include "FbWindow.hh"
 #include "TextUtils.hh"
+#include "ImageTransform.hh"
 
 #include <X11/Xutil.h>
 #include <X11/Xatom.h>
+#ifdef HAVE_XRENDER
+#include <X11/extensions/Xrender.h>
+#endif // HAVE_XRENDER
 #include <iostream>
 #include <vector>
 #ifdef HAVE_CSTRING
@@ -35,6 +39,11 @@
 #else
   #include <string.h>
 #endif
+#ifdef HAVE_CSTDLIB
+  #include <cstdlib>
+#else
+  #include <stdlib.h>
+#endif
 
 using std::cerr;
 
@@ -64,6 +73,146 @@ void checkAtoms() {
     }
 }
 
+/// XImage as source of ImageTransform
+struct ImageSource {
+    explicit ImageSource(XImage *image): m_image(image) { }
+    unsigned long pixel(int x, int y) const { return XGetPixel(m_image, x, y); }
+    XImage *m_image;
+};
+
+/// XImage as destination of ImageTransform
+struct ImageDest {
+    explicit ImageDest(XImage *image): m_image(image) { }
+    void setPixel(int x, int y, unsigned long pixel) { XPutPixel(m_image, x, y, pixel); }
+    XImage *m_image;
+};
+
+/// client side image with the same format as src, but of a different size
+XImage *createImage(Display *disp, XImage *src, unsigned int width, unsigned int height) {
+    XImage *image = XCreateImage(disp, DefaultVisual(disp, DefaultScreen(disp)),
+                                 src->depth, ZPixmap, 0, 0,
+                                 width, height, src->bitmap_pad, 0);
+    if (image == 0)
+        return 0;
+
+    image->data = static_cast<char *>(malloc(image->bytes_per_line * height));
+    if (image->data == 0) {
+        XDestroyImage(image);
+        return 0;
+    }
+    return image;
+}
+
+#ifdef HAVE_XRENDER
+
+/**
+   Let the server transform src into dest, no pixel data crosses the wire.
+   The transform maps destination coordinates to source coordinates.
+   @return false if the server can't do it for this depth
+ */
+bool renderTransform(Display *disp, Pixmap src, Pixmap dest, unsigned int depth,
+                     XTransform &transform, const char *filter,
+                     unsigned int dest_width, unsigned int dest_height) {
+
+    // RepeatPad (to not blend the edges with black) needs render 0.10
+    static int s_render_ok = -1;
+    if (s_render_ok < 0) {
+        int major = 0, minor = 0;
+        s_render_ok = Transparent::haveRender() &&
+            XRenderQueryVersion(disp, &major, &minor) &&
+            (major > 0 || minor >= 10);
+    }
+    if (!s_render_ok)
+        return false;
+
+    XRenderPictFormat *format = 0;
+    if (depth == 32)
+        format = XRenderFindStandardFormat(disp, PictStandardARGB32);
+    else if (depth == 24)
+        format = XRenderFindStandardFormat(disp, PictStandardRGB24);
+    if (format == 0)
+        return false;
+
+    XRenderPictureAttributes attr;
+    attr.repeat = RepeatPad;
+    Picture src_pic = XRenderCreatePicture(disp, src, format, CPRepeat, &attr);
+    Picture dest_pic = XRenderCreatePicture(disp, dest, format, 0, 0);
+
+    XRenderSetPictureTransform(disp, src_pic, &transform);
+    XRenderSetPictureFilter(disp, src_pic, filter, 0, 0);
+    XRenderComposite(disp, PictOpSrc, src_pic, None, dest_pic,
+                     0, 0, 0, 0, 0, 0, dest_width, dest_height);
+
+    XRenderFreePicture(disp, dest_pic);
+    XRenderFreePicture(disp, src_pic);
+    return true;
+}
+
+void setTransform(XTransform &transform,
+                  double xx, double xy, double x0,
+                  double yx, double yy, double y0) {
+    transform.matrix[0][0] = XDoubleToFixed(xx);
+    transform.matrix[0][1] = XDoubleToFixed(xy);
+    transform.matrix[0][2] = XDoubleToFixed(x0);
+    transform.matrix[1][0] = XDoubleToFixed(yx);
+    transform.matrix[1][1] = XDoubleToFixed(yy);
+    transform.matrix[1][2] = XDoubleToFixed(y0);
+    transform.matrix[2][0] = 0;
+    transform.matrix[2][1] = 0;
+    transform.matrix[2][2] = XDoubleToFixed(1);
+}
+
+#endif // HAVE_XRENDER
+
+/**
+   Transform the pixels on our side: one XGetImage, one XPutImage.
+   op is called with the source and destination images.
+ */
+template <typename Op>
+void clientTransform(Display *disp, Pixmap src, unsigned int width, unsigned int height,
+                     FbPixmap &dest, Op op) {
+    XImage *src_image = XGetImage(disp, src,
+                                  0, 0, // pos
+                                  width, height, // size
+                                  ~0, // plane mask
+                                  ZPixmap); // format
+    if (src_image == 0)
+        return;
+
+    XImage *dest_image = createImage(disp, src_image, dest.width(), dest.height());
+    if (dest_image) {
+        ImageSource source(src_image);
+        ImageDest target(dest_image);
+        op(source, target);
+
+        GContext gc(dest);
+        XPutImage(disp, dest.drawable(), gc.gc(), dest_image,
+                  0, 0, 0, 0, dest.width(), dest.height());
+        XDestroyImage(dest_image);
+    }
+
+    XDestroyImage(src_image);
+}
+
+struct RotateOp {
+    RotateOp(unsigned int w, unsigned int h, Orientation o):
+        width(w), height(h), orient(o) { }
+    void operator()(const ImageSource &src, ImageDest &dest) const {
+        ImageTransform::rotate(src, width, height, dest, orient);
+    }
+    unsigned int width, height;
+    Orientation orient;
+};
+
+struct ScaleOp {
+    ScaleOp(unsigned int w, unsigned int h, unsigned int dw, unsigned int dh):
+        width(w), height(h), dest_width(dw), dest_height(dh) { }
+    void operator()(const ImageSource &src, ImageDest &dest) const {
+        ImageTransform::scale(src, width, height, dest, dest_width, dest_height);
+    }
+    unsigned int width, height, dest_width, dest_height;
+};
+
 } // end of anonymous namespace
 
 FbPixmap::FbPixmap():m_pm(0),
@@ -154,7 +303,7 @@ void FbPixmap::copy(const FbPixmap &the_copy) {
                the_copy.depth());
 
         if (drawable()) {
-            GContext gc(drawable());
+            GContext gc(*this);
 
             copyArea(the_copy.drawable(),
                      gc.gc(),
@@ -192,23 +341,21 @@ void FbPixmap::copy(Pixmap pm, unsigned int depth, int screen_num) {
     // create new pixmap and copy area
     create(root, new_width, new_height, depth);
 
-    GC gc = XCreateGC(display(), drawable(), 0, 0);
+    GContext gc(*this);
 
     if (depth == bpp) {
-        XCopyArea(display(), pm, drawable(), gc,
+        XCopyArea(display(), pm, drawable(), gc.gc(),
                   0, 0,
                   width(), height(),
                   0, 0);
     } else {
-        XSetForeground(display(), gc, Color("black", screen_num).pixel());
-        XSetBackground(display(), gc, Color("white", screen_num).pixel());
-        XCopyPlane(display(), pm, drawable(), gc,
+        gc.setForeground(Color("black", screen_num));
+        gc.setBackground(Color("white", screen_num));
+        XCopyPlane(display(), pm, drawable(), gc.gc(),
                    0, 0,
                    width(), height(),
                    0, 0, 1);
     }
-
-    XFreeGC(display(), gc);
 }
 
 void FbPixmap::rotate(FbTk::Orientation orient) {
@@ -223,64 +370,31 @@ void FbPixmap::rotate(FbTk::Orientation orient) {
     FbPixmap new_pm(drawable(), neww, newh, depth());
 
     // width|height could be 0. this happens (for example) if
-    // the systemtray-tool is ROT90. in that case 'src_image'
-    // becomes NULL and caused a SIGSEV upon XDestroyImage()
-    // TODO: catch dimensions with '0' earlier?
-    //
-    // make an image copy
-    XImage *src_image = XGetImage(display(), drawable(),
-                                  0, 0, // pos
-                                  oldw, oldh, // size
-                                  ~0, // plane mask
-                                  ZPixmap); // format
-    if (src_image) {
-
-        GContext gc(drawable());
-
-        if (orient == ROT180) {
-            unsigned int srcx, srcy, destx, desty;
-            for (srcy = 0, desty = oldh; srcy < oldh; ++srcy, --desty) {
-                for (srcx = 0, destx = oldw; srcx < oldw; ++srcx, --destx) {
-                    gc.setForeground(XGetPixel(src_image, srcx, srcy));
-                    XDrawPoint(display(), new_pm.drawable(), gc.gc(), destx, desty);
-                }
-            }
-        } else {
-            // need to flip x and y
-
-            // set start, end and direction based on rotation
-            // NOTE that startx etc are in the direction of the OLD pixmap
-            unsigned int startx = 0, starty = 0;
-            int dirx = 0, diry = 0;
-            switch (orient) {
-            case ROT90:
-                startx = neww-1;
-                starty = 0;
-                dirx = -1;
-                diry = 1;
-                break;
-            case ROT270:
-                startx = 0;
-                starty = newh-1;
-                dirx = 1;
-                diry = -1;
-                break;
-            default: // kill warning
-                break;
-            }
-
-
-            // copy new area
-            unsigned int srcx, srcy, destx, desty;
-            for (srcy = 0, destx = startx; srcy < oldh; ++srcy, destx+=dirx) {
-                for (srcx = 0, desty = starty; srcx < oldw; ++srcx, desty+=diry) {
-                    gc.setForeground(XGetPixel(src_image, srcx, srcy));
-                    XDrawPoint(display(), new_pm.drawable(), gc.gc(), destx, desty);
-                }
-            }
+    // the systemtray-tool is ROT90. in that case there is nothing
+    // to transform and the X calls would fail
+    if (oldw > 0 && oldh > 0 && new_pm.drawable() != 0) {
+        bool done = false;
+#ifdef HAVE_XRENDER
+        // map destination to source coordinates, a rotation by a
+        // multiple of 90 degrees hits the pixel centers exactly
+        XTransform transform;
+        switch (orient) {
+        case ROT90:
+            setTransform(transform, 0, 1, 0, -1, 0, oldh);
+            break;
+        case ROT180:
+            setTransform(transform, -1, 0, oldw, 0, -1, oldh);
+            break;
+        default: // ROT270
+            setTransform(transform, 0, -1, oldw, 1, 0, 0);
+            break;
         }
-
-        XDestroyImage(src_image);
+        done = renderTransform(display(), drawable(), new_pm.drawable(), depth(),
+                               transform, FilterNearest, neww, newh);
+#endif // HAVE_XRENDER
+        if (!done)
+            clientTransform(display(), drawable(), oldw, oldh, new_pm,
+                            RotateOp(oldw, oldh, orient));
     }
 
     // free old pixmap and set new from new_pm
@@ -294,39 +408,28 @@ void FbPixmap::rotate(FbTk::Orientation orient) {
 
 void FbPixmap::scale(unsigned int dest_width, unsigned int dest_height) {
 
-    if (drawable() == 0 ||
+    if (drawable() == 0 || width() == 0 || height() == 0 ||
+        dest_width == 0 || dest_height == 0 ||
         (dest_width == width() && dest_height == height()))
         return;
 
-    XImage *src_image = XGetImage(display(), drawable(),
-                                  0, 0, // pos
-                                  width(), height(), // size
-                                  ~0, // plane mask
-                                  ZPixmap); // format
-    if (src_image == 0)
-        return;
-
     // create new pixmap with dest size
     FbPixmap new_pm(drawable(), dest_width, dest_height, depth());
+    if (new_pm.drawable() == 0)
+        return;
 
-    GContext gc(drawable());
-    // calc zoom
-    float zoom_x = static_cast<float>(width())/static_cast<float>(dest_width);
-    float zoom_y = static_cast<float>(height())/static_cast<float>(dest_height);
-
-    // start scaling
-    float src_x = 0, src_y = 0;
-    for (unsigned int tx=0; tx < dest_width; ++tx, src_x += zoom_x) {
-        src_y = 0;
-        for (unsigned int ty=0; ty < dest_height; ++ty, src_y += zoom_y) {
-            gc.setForeground(XGetPixel(src_image,
-                                       static_cast<int>(src_x),
-                                       static_cast<int>(src_y)));
-            XDrawPoint(display(), new_pm.drawable(), gc.gc(), tx, ty);
-        }
-    }
-
-    XDestroyImage(src_image);
+    bool done = false;
+#ifdef HAVE_XRENDER
+    XTransform transform;
+    setTransform(transform,
+                 static_cast<double>(width())/dest_width, 0, 0,
+                 0, static_cast<double>(height())/dest_height, 0);
+    done = renderTransform(display(), drawable(), new_pm.drawable(), depth(),
+                           transform, FilterBilinear, dest_width, dest_height);
+#endif // HAVE_XRENDER
+    if (!done)
+        clientTransform(display(), drawable(), width(), height(), new_pm,
+                        ScaleOp(width(), height(), dest_width, dest_height));
 
     // free old pixmap and set new from new_pm
     free();
@@ -486,9 +589,16 @@ Pixmap FbPixmap::getRootPixmap(int screen_num, bool force_update) {
     return s_root_pixmaps[screen_num];
 }
 
+Signal<Pixmap> &FbPixmap::freeSig() {
+    static Signal<Pixmap> s_free_sig;
+    return s_free_sig;
+}
+
 void FbPixmap::free() {
-    if (!m_dont_free && m_pm != 0)
+    if (!m_dont_free && m_pm != 0) {
+        freeSig().emit(m_pm);
         XFreePixmap(display(), m_pm);
+    }
 
     /* note: m_dont_free shouldnt be required anywhere else,
        because then free() isn't being called appropriately! */
@@ -24,6 +24,7 @@
 
 #include "FbDrawable.hh"
 #include "Orientation.hh"
+#include "Signal.hh"
 
 namespace FbTk {
 
@@ -76,6 +77,9 @@ public:
     /* Will be reset to false whenever this pixmap is reassigned */
     void dontFree() { m_dont_free = true; }
 
+    /// emitted with each pixmap id we free, before the server can reuse it
+    static Signal<Pixmap> &freeSig();
+
 private:
     void free();
 
@@ -25,6 +25,7 @@
 
 #include "EventManager.hh"
 #include "Color.hh"
+#include "GContext.hh"
 #include "App.hh"
 #include "Transparent.hh"
 
@@ -38,6 +39,20 @@
 
 namespace FbTk {
 
+namespace {
+
+// background pixmaps may be smaller than the window (see
+// ImageControl::renderBackground), so fill them in tiled like the server does
+void fillWithBackground(FbDrawable &dest, GContext &gc, Pixmap bg,
+                        unsigned int width, unsigned int height) {
+    gc.setTile(bg);
+    gc.setFillStyle(FillTiled);
+    dest.fillRectangle(gc.gc(), 0, 0, width, height);
+    gc.setFillStyle(FillSolid);
+}
+
+} // end anonymous namespace
+
 Window FbWindow::rootWindow(Display* dpy, Drawable win) {
     union { int i; unsigned int ui; } ignore;
     Window root = None;
@@ -140,6 +155,7 @@ FbWindow::~FbWindow() {
         removeAlphaWin(*this);
         m_transparent.reset(0);
     }
+    releaseBackgroundLayer();
 
     if (m_window != 0) {
         // so we don't get any dangling eventhandler for this window
@@ -159,6 +175,7 @@ void FbWindow::setBackgroundColor(const FbTk::Color &bg_color) {
         m_lastbg_color_set = false;
     }
 
+    releaseBackgroundLayer();
     updateBackground(false);
 }
 
@@ -167,12 +184,33 @@ void FbWindow::setBackgroundPixmap(Pixmap bg_pixmap) {
     if (bg_pixmap != None)
         m_lastbg_color_set = false;
 
+    // the pixmap id might be a recycled one with new content
+    releaseBackgroundLayer();
     updateBackground(false);
 }
 
 void FbWindow::invalidateBackground() {
     m_lastbg_pm = None;
     m_lastbg_color_set = false;
+    releaseBackgroundLayer();
+}
+
+void FbWindow::releaseBackgroundLayer() {
+    if (m_bg_layer.pixmap != None)
+        XFreePixmap(display(), m_bg_layer.pixmap);
+    m_bg_layer = BackgroundLayer();
+}
+
+void FbWindow::rootPosition(int &root_x, int &root_y) const {
+    const FbWindow *root_parent = parent();
+    // our position in parent ("root")
+    root_x = x() + borderWidth();
+    root_y = y() + borderWidth();
+    while (root_parent != 0) {
+        root_x += root_parent->x() + root_parent->borderWidth();
+        root_y += root_parent->y() + root_parent->borderWidth();
+        root_parent = root_parent->parent();
+    }
 }
 
 void FbWindow::updateBackground(bool only_if_alpha) {
@@ -192,54 +230,67 @@ void FbWindow::updateBackground(bool only_if_alpha) {
     // still use bg buffer pixmap if not transparent
     // cause it does nice caching things, assuming we have a renderer
     if (m_lastbg_pm != ParentRelative && (m_renderer || alpha != 255)) {
-        // update source and destination if needed
-        Pixmap root = FbPixmap::getRootPixmap(screenNumber());
-        if (alpha != 255 && m_transparent->source() != root)
-            m_transparent->setSource(root, screenNumber());
+        GContext gc(*this);
+
+        if (alpha != 255) {
+            // update source if needed
+            Pixmap root = FbPixmap::getRootPixmap(screenNumber());
+            if (m_transparent->source() != root)
+                m_transparent->setSource(root, screenNumber());
+
+            int root_x, root_y;
+            rootPosition(root_x, root_y);
+
+            if (m_bg_layer.pixmap == None || m_bg_layer.root != root ||
+                m_bg_layer.x != root_x || m_bg_layer.y != root_y ||
+                m_bg_layer.width != width() || m_bg_layer.height != height() ||
+                m_bg_layer.alpha != alpha) {
+
+                releaseBackgroundLayer();
+                FbPixmap layer(*this, width(), height(), depth());
+                if (m_lastbg_pm == None) {
+                    gc.setForeground(m_lastbg_color);
+                    layer.fillRectangle(gc.gc(), 0, 0, width(), height());
+                } else
+                    fillWithBackground(layer, gc, m_lastbg_pm, width(), height());
+
+                // render background image from root pos to our window
+                m_transparent->setDest(layer.drawable(), screenNumber());
+                m_transparent->render(root_x, root_y,
+                                      0, 0,
+                                      width(), height());
+                m_transparent->freeDest(); // it's only temporary, don't leave it hanging around
+
+                m_bg_layer.pixmap = layer.release();
+                m_bg_layer.root = root;
+                m_bg_layer.x = root_x;
+                m_bg_layer.y = root_y;
+                m_bg_layer.width = width();
+                m_bg_layer.height = height();
+                m_bg_layer.alpha = alpha;
+            }
+        } else
+            releaseBackgroundLayer();
 
         FbPixmap newpm = FbPixmap(*this, width(), height(), depth());
         free_newbg = true; // newpm gets released to newbg at end of block
-        GC gc = XCreateGC(display(), window(), 0, 0);
 
-        if (m_lastbg_pm == None && m_lastbg_color_set) {
-            XSetForeground(display(), gc, m_lastbg_color);
-            newpm.fillRectangle(gc, 0, 0, width(), height());
+        if (m_bg_layer.pixmap != None) {
+            newpm.copyArea(m_bg_layer.pixmap, gc.gc(), 0, 0, 0, 0, width(), height());
+        } else if (m_lastbg_pm == None && m_lastbg_color_set) {
+            gc.setForeground(m_lastbg_color);
+            newpm.fillRectangle(gc.gc(), 0, 0, width(), height());
+        } else if (m_lastbg_pm != None) {
+            fillWithBackground(newpm, gc, m_lastbg_pm, width(), height());
         } else {
             // copy from window if no color and no bg...
-            newpm.copyArea((m_lastbg_pm == None)?drawable():m_lastbg_pm, gc, 0, 0, 0, 0, width(), height());
-        }
-        XFreeGC(display(), gc);
-
-        if (alpha != 255)
-            m_transparent->setDest(newpm.drawable(), screenNumber());
-
-        // get root position
-
-        const FbWindow *root_parent = parent();
-        // our position in parent ("root")
-        int root_x = x() + borderWidth(), root_y = y() + borderWidth();
-        if (root_parent != 0) {
-            root_x += root_parent->x() + root_parent->borderWidth();
-            root_y += root_parent->y() + root_parent->borderWidth();
-            while (root_parent->parent() != 0) {
-                root_parent = root_parent->parent();
-                root_x += root_parent->x() + root_parent->borderWidth();
-                root_y += root_parent->y() + root_parent->borderWidth();
-            }
+            newpm.copyArea(drawable(), gc.gc(), 0, 0, 0, 0, width(), height());
         }
 
-        // render background image from root pos to our window
-        if (alpha != 255)
-            m_transparent->render(root_x, root_y,
-                                  0, 0,
-                                  width(), height());
-
         // render any foreground items
         if (m_renderer)
             m_renderer->renderForeground(*this, newpm);
 
-        if (alpha != 255)
-            m_transparent->freeDest(); // it's only temporary, don't leave it hanging around
         newbg = newpm.release();
     }
 
@@ -342,20 +393,8 @@ void FbWindow::updateTransparent(int the_x, int the_y, unsigned int the_width, u
         m_transparent->setDest(dest_override, screenNumber());
 
     // get root position
-
-    const FbWindow *root_parent = parent();
-    // our position in parent ("root")
-    int root_x = x() + borderWidth(), root_y = y() + borderWidth();
-    if (root_parent != 0) {
-        root_x += root_parent->x() + root_parent->borderWidth();
-        root_y += root_parent->y() + root_parent->borderWidth();
-        while (root_parent->parent() != 0) {
-            root_parent = root_parent->parent();
-            root_x += root_parent->x() + root_parent->borderWidth();
-            root_y += root_parent->y() + root_parent->borderWidth();
-        }
-
-    } // else toplevel window so we already have x, y set
+    int root_x, root_y;
+    rootPosition(root_x, root_y);
 
     // render background image from root pos to our window
     m_transparent->render(root_x + the_x, root_y + the_y,
@@ -400,6 +439,7 @@ int FbWindow::alpha() const {
 }
 
 FbWindow &FbWindow::operator = (const FbWindow &win) {
+    releaseBackgroundLayer();
     m_parent = win.parent();
     m_screen_num = win.screenNumber();
     m_window = win.window();
@@ -425,6 +465,7 @@ void FbWindow::setNew(Window win) {
     if (m_window != 0 && m_destroy)
         XDestroyWindow(display(), m_window);
 
+    releaseBackgroundLayer();
     m_window = win;
 
     if (m_window != 0) {
@@ -733,6 +774,8 @@ void FbWindow::updatedAlphaBackground(int screen) {
     FbWinList::iterator it_end = m_alpha_wins.end();
     for (; it != it_end; ++it) {
         if ((*it)->screenNumber() == screen) {
+            // the root pixmap might have been redrawn in place
+            (*it)->releaseBackgroundLayer();
             (*it)->updateBackground(false);
             (*it)->clear();
         }
@@ -24,6 +24,7 @@
 
 #include "FbDrawable.hh"
 #include "FbString.hh"
+#include "MemoryPool.hh"
 
 #include <memory>
 #include <string>
@@ -48,7 +49,7 @@ class FbWindowRenderer;
  * @see EventHandler
  * @see EventManager
  */
-class FbWindow: public FbDrawable {
+class FbWindow: public FbDrawable, public PoolAllocated {
 public:
 
     static Window rootWindow(Display* dpy, Drawable win);
@@ -222,6 +223,10 @@ protected:
 private:
     /// sets new X window and destroys old
     void setNew(Window win);
+    /// position of our top left inner corner on the root window
+    void rootPosition(int &root_x, int &root_y) const;
+    /// drops the cached transparent background
+    void releaseBackgroundLayer();
     /// creates a new X window
     void create(Window parent, int x, int y, unsigned int width, unsigned int height,
                 long eventmask,
@@ -246,6 +251,21 @@ private:
     unsigned long m_lastbg_color;
     Pixmap m_lastbg_pm;
 
+    /**
+       The background blended over the root window, before any foreground
+       is rendered. Foreground only changes (a clock tick, a new title)
+       just copy it instead of compositing the root pixmap again.
+     */
+    struct BackgroundLayer {
+        BackgroundLayer(): pixmap(None), root(None), x(0), y(0),
+                           width(0), height(0), alpha(255) { }
+        Pixmap pixmap;
+        Pixmap root; ///< root pixmap the layer was blended with
+        int x, y;    ///< root position the layer was blended at
+        unsigned int width, height;
+        int alpha;
+    } m_bg_layer;
+
     FbWindowRenderer *m_renderer;
 
     static void addAlphaWin(FbWindow &win);
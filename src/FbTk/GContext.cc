@@ -27,41 +27,115 @@
 #include "Color.hh"
 #include "Font.hh"
 
+#include <map>
+#include <vector>
+
+namespace {
+
+/// GCs kept per depth for later GContexts
+const size_t MAX_POOLED_GCS = 8;
+
+/// everything a GC has
+const unsigned long ALL_GC_VALUES = (1L << (GCLastBit + 1)) - 1;
+
+struct GCPool {
+    std::vector<GC> free;
+    GC defaults; ///< never drawn with, new GCs are reset from it
+};
+
+typedef std::map<unsigned int, GCPool> GCPools;
+GCPools s_pools;
+
+} // end anonymous namespace
+
 namespace FbTk {
 
 Display *GContext::m_display = 0;
 
 GContext::GContext(const FbTk::FbDrawable &drawable):
-    m_gc(XCreateGC(drawable.display(), drawable.drawable(), 0, 0)) {
+    m_gc(0), m_depth(0), m_known(0) {
 
     if (m_display == 0)
         m_display = drawable.display();
 
-    setGraphicsExposure(false);
+    acquire(drawable.drawable(), drawable.depth());
 }
 
 GContext::GContext(Drawable drawable):
-    m_gc(XCreateGC(m_display != 0 ? m_display : FbTk::App::instance()->display(),
-                   drawable,
-                   0, 0)) {
+    m_gc(0), m_depth(0), m_known(0) {
     if (m_display == 0)
         m_display = FbTk::App::instance()->display();
-    setGraphicsExposure(false);
+    acquire(drawable, 0);
 }
 
 GContext::GContext(Drawable d, const GContext &gc):
-    m_gc(XCreateGC(m_display != 0 ? m_display : FbTk::App::instance()->display(),
-                   d,
-                   0, 0)) {
+    m_gc(0), m_depth(0), m_known(0) {
     if (m_display == 0)
         m_display = FbTk::App::instance()->display();
-    setGraphicsExposure(false);
+    acquire(d, 0);
     copy(gc);
 }
 
 GContext::~GContext() {
-    if (m_gc)
-        XFreeGC(m_display, m_gc);
+    if (m_gc == 0)
+        return;
+
+    if (m_depth != 0) {
+        std::vector<GC> &free = s_pools[m_depth].free;
+        if (free.size() < MAX_POOLED_GCS) {
+            free.push_back(m_gc);
+            return;
+        }
+    }
+    XFreeGC(m_display, m_gc);
+}
+
+void GContext::acquire(Drawable drawable, unsigned int depth) {
+    // GCs only work on the screen they were made for, so sharing them
+    // would need the root of the drawable, which costs a round trip
+    if (ScreenCount(m_display) != 1)
+        depth = 0;
+
+    if (depth != 0) {
+        GCPools::iterator it = s_pools.find(depth);
+        if (it == s_pools.end()) {
+            it = s_pools.insert(std::make_pair(depth, GCPool())).first;
+            it->second.defaults = XCreateGC(m_display, drawable, 0, 0);
+            XSetGraphicsExposures(m_display, it->second.defaults, False);
+        }
+        GCPool &pool = it->second;
+        m_depth = depth;
+        if (!pool.free.empty()) {
+            m_gc = pool.free.back();
+            pool.free.pop_back();
+            XCopyGC(m_display, pool.defaults, ALL_GC_VALUES, m_gc);
+            setDefaults();
+            return;
+        }
+    }
+
+    m_gc = XCreateGC(m_display, drawable, 0, 0);
+    setDefaults();
+    XSetGraphicsExposures(m_display, m_gc, False);
+}
+
+void GContext::setDefaults() {
+    // what XCreateGC starts with, and no graphics exposures
+    m_values.function = GXcopy;
+    m_values.foreground = 0;
+    m_values.background = 1;
+    m_values.line_width = 0;
+    m_values.line_style = LineSolid;
+    m_values.cap_style = CapButt;
+    m_values.join_style = JoinMiter;
+    m_values.fill_style = FillSolid;
+    m_values.subwindow_mode = ClipByChildren;
+    m_values.graphics_exposures = False;
+    m_values.clip_mask = None;
+    m_known = GCFunction | GCForeground | GCBackground |
+              GCLineWidth | GCLineStyle | GCCapStyle | GCJoinStyle |
+              GCFillStyle | GCSubwindowMode | GCGraphicsExposures |
+              GCClipMask;
 }
 
 /// not implemented!
@@ -71,14 +145,17 @@ GContext::~GContext() {
 void GContext::copy(GC gc) {
     // copy gc with mask: all
     XCopyGC(m_display, gc, ~0, m_gc);
+    // whatever it was set to
+    m_known = 0;
 }
 
 void GContext::copy(const GContext &gc) {
     // copy X gc
     copy(gc.gc());
 
-    //!! TODO: copy our extended gcontext
-
+    // and what we know about it
+    m_values = gc.m_values;
+    m_known = gc.m_known;
 }
 
 } // end namespace FbTk
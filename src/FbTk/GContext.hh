@@ -30,7 +30,21 @@ namespace FbTk {
 class FbDrawable;
 class Font;
 
-/// wrapper for X GC
+/**
+   wrapper for X GC
+
+   GContexts for an FbDrawable with a known depth take their GC from a
+   per depth pool, and give it back when they are destroyed, instead of
+   creating and freeing one each time. Pooled GCs are reset to the
+   defaults of a new GC when they are handed out.
+
+   The setters remember what they set and don't repeat a request that
+   wouldn't change anything. Code that changes gc() directly through Xlib
+   has to restore what it changed before the setters are used again; the
+   menu items and window buttons do that with the clip mask, setting it
+   back to None. The font is not remembered, since the font
+   implementations set it on the GC they are given.
+ */
 class GContext {
 public:
 
@@ -62,8 +76,12 @@ public:
     }
 
     void setForeground(long pixel_value) {
+        if (known(GCForeground) && m_values.foreground == (unsigned long)pixel_value)
+            return;
         XSetForeground(m_display, m_gc,
                        pixel_value);
+        m_values.foreground = pixel_value;
+        m_known |= GCForeground;
     }
 
     void setBackground(const FbTk::Color &color) {
@@ -71,11 +89,19 @@ public:
     }
 
     void setBackground(long pixel_value) {
+        if (known(GCBackground) && m_values.background == (unsigned long)pixel_value)
+            return;
         XSetBackground(m_display, m_gc, pixel_value);
+        m_values.background = pixel_value;
+        m_known |= GCBackground;
     }
 
     void setTile(Drawable draw) {
+        if (known(GCTile) && m_values.tile == draw)
+            return;
         XSetTile(m_display, m_gc, draw);
+        m_values.tile = draw;
+        m_known |= GCTile;
     }
 
     void setTile(const FbTk::FbPixmap &draw) {
@@ -85,24 +111,59 @@ public:
     /// not implemented
     void setFont(const FbTk::Font &) {}
 
-    /// set font id
+    /// set font id, always sent since XFontImp sets it behind our back
     void setFont(int fid) {
         XSetFont(m_display, m_gc, fid);
     }
 
+    /**
+       set clip mask, and its origin if it isn't None.
+       The origin is always sent with a mask, since it is left behind
+       by code that clips on gc() directly.
+     */
+    void setClipMask(Pixmap mask, int x = 0, int y = 0) {
+        if (mask != None)
+            XSetClipOrigin(m_display, m_gc, x, y);
+        else if (known(GCClipMask) && m_values.clip_mask == None)
+            return;
+        XSetClipMask(m_display, m_gc, mask);
+        m_values.clip_mask = mask;
+        m_known |= GCClipMask;
+    }
+
+    void setClipMask(const FbTk::FbPixmap &mask, int x = 0, int y = 0) {
+        setClipMask(mask.drawable(), x, y);
+    }
+
     void setGraphicsExposure(bool value) {
+        if (known(GCGraphicsExposures) && m_values.graphics_exposures == value)
+            return;
         XSetGraphicsExposures(m_display, m_gc, value);
+        m_values.graphics_exposures = value;
+        m_known |= GCGraphicsExposures;
     }
 
     void setFunction(int func) {
+        if (known(GCFunction) && m_values.function == func)
+            return;
         XSetFunction(m_display, m_gc, func);
+        m_values.function = func;
+        m_known |= GCFunction;
     }
 
     void setSubwindowMode(int mode) {
+        if (known(GCSubwindowMode) && m_values.subwindow_mode == mode)
+            return;
         XSetSubwindowMode(m_display, m_gc, mode);
+        m_values.subwindow_mode = mode;
+        m_known |= GCSubwindowMode;
     }
     void setFillStyle(int style) {
+        if (known(GCFillStyle) && m_values.fill_style == style)
+            return;
         XSetFillStyle(m_display, m_gc, style);
+        m_values.fill_style = style;
+        m_known |= GCFillStyle;
     }
 
     void setLineAttributes(unsigned int width,
@@ -110,7 +171,17 @@ public:
                                   int cap_style,
                                   int join_style) {
 
+        const unsigned long mask = GCLineWidth | GCLineStyle | GCCapStyle | GCJoinStyle;
+        if (known(mask) && m_values.line_width == (int)width &&
+            m_values.line_style == line_style &&
+            m_values.cap_style == cap_style && m_values.join_style == join_style)
+            return;
         XSetLineAttributes(m_display, m_gc, width, line_style, cap_style, join_style);
+        m_values.line_width = width;
+        m_values.line_style = line_style;
+        m_values.cap_style = cap_style;
+        m_values.join_style = join_style;
+        m_known |= mask;
     }
 
 
@@ -124,8 +195,17 @@ public:
 private:
     GContext(const GContext &cont);
 
+    /// gets a GC for depth from the pool, or creates one
+    void acquire(Drawable drawable, unsigned int depth);
+    /// the GC has its default values, as far as we know
+    void setDefaults();
+    bool known(unsigned long mask) const { return (m_known & mask) == mask; }
+
     static Display *m_display; // worth caching
     GC m_gc;
+    unsigned int m_depth; ///< depth of the pool m_gc belongs to, 0 if none
+    XGCValues m_values; ///< what m_gc is set to
+    unsigned long m_known; ///< mask of the m_values that are up to date
 };
 
 } // end namespace FbTk
@@ -26,8 +26,10 @@
 
 #include "TextureRender.hh"
 #include "Texture.hh"
+#include "FbPixmap.hh"
 #include "App.hh"
 #include "SimpleCommand.hh"
+#include "MemFun.hh"
 #include "I18n.hh"
 
 #ifdef HAVE_SYS_TYPES_H
@@ -46,6 +48,7 @@
 #endif
 
 #include <iostream>
+#include <algorithm>
 
 using std::cerr;
 using std::endl;
@@ -61,6 +64,9 @@ bool s_timed_cache = true;
 bool s_timed_cache = false;
 #endif // TIMEDCACHE
 
+// width of the backgrounds renderBackground() lets the server tile
+const unsigned int BACKGROUND_STRIP_SIZE = 8;
+
 
 void initColortables(unsigned char red[256], unsigned char green[256], unsigned char blue[256],
       int red_bits, int green_bits, int blue_bits) {
@@ -164,6 +170,13 @@ struct ImageControl::Cache {
     unsigned long pixel1, pixel2, texture;
 };
 
+struct ImageControl::ScaledCache {
+    Pixmap pixmap;
+    Pixmap src;
+    Orientation orient;
+    unsigned int count, width, height, depth;
+};
+
 ImageControl::ImageControl(int screen_num,
                            int cpc, unsigned long cache_timeout, unsigned long cmax):
     m_colors_per_channel(cpc),
@@ -185,6 +198,9 @@ ImageControl::ImageControl(int screen_num,
     }
 
     createColorTable();
+
+    m_tracker.join(FbPixmap::freeSig(),
+                   MemFun(*this, &ImageControl::scaledSourceFreed));
 }
 
 
@@ -209,6 +225,10 @@ ImageControl::~ImageControl() {
             delete (*it);
         }
     }
+
+    ScaledCacheList::iterator sit = m_scaled_cache.begin();
+    for (; sit != m_scaled_cache.end(); ++sit)
+        XFreePixmap(disp, sit->pixmap);
 }
 
 
@@ -322,10 +342,84 @@ Pixmap ImageControl::renderImage(unsigned int width, unsigned int height,
 }
 
 
+Pixmap ImageControl::renderBackground(unsigned int width, unsigned int height,
+                                      const FbTk::Texture &texture,
+                                      FbTk::Orientation orient) {
+
+    if (texture.sameAlongRows()) {
+        if (orient == ROT0 || orient == ROT180)
+            width = std::min(width, BACKGROUND_STRIP_SIZE);
+        else
+            height = std::min(height, BACKGROUND_STRIP_SIZE);
+    }
+
+    return renderImage(width, height, texture, orient);
+}
+
+Pixmap ImageControl::scaledPixmap(Pixmap src, unsigned int width, unsigned int height,
+                                  unsigned int depth, Orientation orient) {
+    if (src == None || width == 0 || height == 0)
+        return None;
+
+    ScaledCacheList::iterator it = m_scaled_cache.begin();
+    ScaledCacheList::iterator it_end = m_scaled_cache.end();
+    for (; it != it_end; ++it) {
+        if (it->src == src && it->width == width && it->height == height &&
+            it->depth == depth && it->orient == orient) {
+            it->count++;
+            return it->pixmap;
+        }
+    }
+
+    FbPixmap pm;
+    pm.copy(src, depth, m_screen_num);
+    if (pm.drawable() == None)
+        return None;
+    pm.scale(width, height);
+    pm.rotate(orient);
+
+    ScaledCache tmp;
+    tmp.pixmap = pm.release();
+    tmp.src = src;
+    tmp.orient = orient;
+    tmp.width = width;
+    tmp.height = height;
+    tmp.depth = depth;
+    tmp.count = 1;
+    m_scaled_cache.push_back(tmp);
+
+    return tmp.pixmap;
+}
+
+void ImageControl::scaledSourceFreed(Pixmap src) {
+    // the copies stay valid for whoever holds them, only the key goes
+    ScaledCacheList::iterator it = m_scaled_cache.begin();
+    ScaledCacheList::iterator it_end = m_scaled_cache.end();
+    for (; it != it_end; ++it) {
+        if (it->src == src)
+            it->src = None;
+    }
+}
+
+
 void ImageControl::removeImage(Pixmap pixmap) {
     if (!pixmap)
         return;
 
+    // scaled copies aren't kept around, nobody asks for the copy of an
+    // icon that is gone
+    ScaledCacheList::iterator sit = m_scaled_cache.begin();
+    ScaledCacheList::iterator sit_end = m_scaled_cache.end();
+    for (; sit != sit_end; ++sit) {
+        if (sit->pixmap == pixmap) {
+            if (--sit->count == 0) {
+                XFreePixmap(FbTk::App::instance()->display(), pixmap);
+                m_scaled_cache.erase(sit);
+            }
+            return;
+        }
+    }
+
     CacheList::iterator it = cache.begin();
     CacheList::iterator it_end = cache.end();
     for (; it != it_end; ++it) {
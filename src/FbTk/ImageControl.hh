@@ -28,6 +28,7 @@
 #include "Orientation.hh"
 #include "Timer.hh"
 #include "NotCopyable.hh"
+#include "Signal.hh"
 
 #include <X11/Xlib.h> // for Visual* etc
 
@@ -66,6 +67,34 @@ public:
                        Orientation orient = ROT0,
                        bool use_cache = true);
 
+    /**
+       Render a window background. Textures that look the same along the
+       whole width (along the height for ROT90 and ROT270) are rendered
+       as a narrow strip, which the server tiles across the window. All
+       windows of the same height then share one pixmap, and resizing
+       them doesn't render anything.
+       Only for pixmaps that are tiled, like window backgrounds.
+       @see renderImage
+    */
+    Pixmap renderBackground(unsigned int width, unsigned int height,
+                            const FbTk::Texture &src_texture,
+                            Orientation orient = ROT0);
+
+    /**
+       Scaled (and rotated) copy of a pixmap. Copies are shared between
+       everyone asking for the same source, size, depth and orientation;
+       release them with removeImage() like rendered images. Sources
+       must be FbPixmaps, so freeing one retires its copies from the cache.
+       @param src pixmap to copy, e.g. a client icon
+       @param width width of the copy before rotation
+       @param height height of the copy before rotation
+       @param depth depth of the copy, 0 keeps the depth of src (for masks)
+       @param orient rotation applied after scaling
+       @return the shared pixmap, on failure None
+    */
+    Pixmap scaledPixmap(Pixmap src, unsigned int width, unsigned int height,
+                        unsigned int depth = 0, Orientation orient = ROT0);
+
     void installRootColormap();
     void removeImage(Pixmap thepix);
     void colorTables(const unsigned char **, const unsigned char **, const unsigned char **,
@@ -82,7 +111,11 @@ private:
     Pixmap searchCache(unsigned int width, unsigned int height, const Texture &text, Orientation orient) const;
 
     void createColorTable();
+    /// src is gone, its id must not find the old scaled copies anymore
+    void scaledSourceFreed(Pixmap src);
+
     Timer m_timer;
+    SignalTracker m_tracker;
 
     Colormap m_colormap;
 
@@ -110,6 +143,11 @@ private:
 
     mutable CacheList cache;
     unsigned long cache_max;
+
+    struct ScaledCache;
+    typedef std::list<ScaledCache> ScaledCacheList;
+
+    ScaledCacheList m_scaled_cache;
 };
 
 } // end namespace FbTk
@@ -0,0 +1,104 @@
+// ImageTransform.hh for FbTk - Fluxbox Toolkit
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef FBTK_IMAGETRANSFORM_HH
+#define FBTK_IMAGETRANSFORM_HH
+
+#include "Orientation.hh"
+
+#include <vector>
+
+namespace FbTk {
+
+/**
+   Client side pixel transforms used by FbPixmap when the server can't
+   do them. The images are accessed through Src::pixel(x, y) and
+   Dest::setPixel(x, y, pixel), so the same code runs on XImages and on
+   plain memory buffers (see tests/testImageTransform.cc).
+ */
+namespace ImageTransform {
+
+/**
+   Source column (or row) for each destination column (or row) when
+   scaling src_size pixels to dest_size pixels with nearest neighbour.
+   The float accumulation matches what FbPixmap::scale always did, so
+   scaled pixmaps stay identical.
+ */
+inline void scaleMap(unsigned int src_size, unsigned int dest_size,
+                     std::vector<unsigned int> &map) {
+    map.resize(dest_size);
+    float zoom = static_cast<float>(src_size)/static_cast<float>(dest_size);
+    float src = 0;
+    for (unsigned int i = 0; i < dest_size; ++i, src += zoom) {
+        unsigned int s = static_cast<unsigned int>(src);
+        map[i] = s < src_size ? s : src_size - 1;
+    }
+}
+
+/// scale src (width x height) to dest (dest_width x dest_height)
+template <typename Src, typename Dest>
+void scale(const Src &src, unsigned int width, unsigned int height,
+           Dest &dest, unsigned int dest_width, unsigned int dest_height) {
+    if (width == 0 || height == 0)
+        return;
+
+    std::vector<unsigned int> map_x, map_y;
+    scaleMap(width, dest_width, map_x);
+    scaleMap(height, dest_height, map_y);
+
+    for (unsigned int y = 0; y < dest_height; ++y) {
+        for (unsigned int x = 0; x < dest_width; ++x)
+            dest.setPixel(x, y, src.pixel(map_x[x], map_y[y]));
+    }
+}
+
+/**
+   rotate src (width x height) into dest, which must be height x width
+   for ROT90 and ROT270
+ */
+template <typename Src, typename Dest>
+void rotate(const Src &src, unsigned int width, unsigned int height,
+            Dest &dest, Orientation orient) {
+    for (unsigned int y = 0; y < height; ++y) {
+        for (unsigned int x = 0; x < width; ++x) {
+            switch (orient) {
+            case ROT0:
+                dest.setPixel(x, y, src.pixel(x, y));
+                break;
+            case ROT90:
+                dest.setPixel(height - 1 - y, x, src.pixel(x, y));
+                break;
+            case ROT180:
+                dest.setPixel(width - 1 - x, height - 1 - y, src.pixel(x, y));
+                break;
+            case ROT270:
+                dest.setPixel(y, width - 1 - x, src.pixel(x, y));
+                break;
+            }
+        }
+    }
+}
+
+} // end namespace ImageTransform
+
+} // end namespace FbTk
+
+#endif // FBTK_IMAGETRANSFORM_HH
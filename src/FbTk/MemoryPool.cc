@@ -0,0 +1,105 @@
+// MemoryPool.cc for FbTk - Fluxbox Toolkit
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "MemoryPool.hh"
+
+#include <new>
+
+namespace FbTk {
+
+namespace {
+
+struct FreeBlock {
+    FreeBlock *next;
+};
+
+const size_t SMALL_CLASSES = MemoryPool::SMALL_SIZE / MemoryPool::GRANULARITY;
+const size_t NUM_CLASSES = SMALL_CLASSES +
+    (MemoryPool::MAX_SIZE - MemoryPool::SMALL_SIZE) / MemoryPool::LARGE_GRANULARITY;
+
+// plain data, so the pool works during static initialization too
+FreeBlock *s_free[NUM_CLASSES];
+MemoryPool::Stats s_stats;
+
+inline size_t sizeClass(size_t size) {
+    if (size <= MemoryPool::SMALL_SIZE)
+        return size == 0 ? 0 : (size - 1) / MemoryPool::GRANULARITY;
+    return SMALL_CLASSES + (size - MemoryPool::SMALL_SIZE - 1) / MemoryPool::LARGE_GRANULARITY;
+}
+
+inline size_t blockSize(size_t index) {
+    if (index < SMALL_CLASSES)
+        return (index + 1) * MemoryPool::GRANULARITY;
+    return MemoryPool::SMALL_SIZE + (index - SMALL_CLASSES + 1) * MemoryPool::LARGE_GRANULARITY;
+}
+
+} // end anonymous namespace
+
+void *MemoryPool::allocate(size_t size) {
+    if (size > MAX_SIZE) {
+        ++s_stats.heap;
+        return ::operator new(size);
+    }
+
+    const size_t index = sizeClass(size);
+    if (s_free[index] == 0) {
+        const size_t block_size = blockSize(index);
+        size_t chunk_size = CHUNK_SIZE;
+        if (chunk_size < block_size * CHUNK_BLOCKS)
+            chunk_size = block_size * CHUNK_BLOCKS;
+        char *chunk = static_cast<char *>(::operator new(chunk_size));
+        for (size_t offset = 0; offset + block_size <= chunk_size; offset += block_size) {
+            FreeBlock *block = reinterpret_cast<FreeBlock *>(chunk + offset);
+            block->next = s_free[index];
+            s_free[index] = block;
+        }
+        ++s_stats.heap;
+    } else
+        ++s_stats.pooled;
+
+    ++s_stats.in_use;
+    FreeBlock *block = s_free[index];
+    s_free[index] = block->next;
+    return block;
+}
+
+void MemoryPool::deallocate(void *p, size_t size) {
+    if (p == 0)
+        return;
+
+    if (size > MAX_SIZE) {
+        ::operator delete(p);
+        return;
+    }
+
+    --s_stats.in_use;
+    FreeBlock *block = static_cast<FreeBlock *>(p);
+    const size_t index = sizeClass(size);
+    block->next = s_free[index];
+    s_free[index] = block;
+}
+
+const MemoryPool::Stats &MemoryPool::stats() {
+    return s_stats;
+}
+
+} // end namespace FbTk
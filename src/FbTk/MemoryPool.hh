@@ -0,0 +1,105 @@
+// MemoryPool.hh for FbTk - Fluxbox Toolkit
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#ifndef FBTK_MEMORYPOOL_HH
+#define FBTK_MEMORYPOOL_HH
+
+#include <cstddef>
+
+namespace FbTk {
+
+/**
+   Free lists of small blocks, for the objects fluxbox creates and
+   destroys with every window: the window and client, frame buttons,
+   tabs, commands, slots and reference counters.
+
+   Blocks are grouped in size classes, GRANULARITY bytes apart up to
+   SMALL_SIZE and LARGE_GRANULARITY bytes apart up to MAX_SIZE, and are
+   carved from larger chunks. Freed blocks go back to their free list
+   and the chunks are never released, so windows that come and go reuse
+   the same memory instead of fragmenting the heap. Larger requests are
+   passed on to operator new.
+ */
+class MemoryPool {
+public:
+    enum {
+        GRANULARITY = 16,
+        SMALL_SIZE = 1024,
+        LARGE_GRANULARITY = 128,
+        MAX_SIZE = 4096, ///< a FluxboxWindow still fits
+        CHUNK_SIZE = 8192, ///< bytes taken from the heap at once...
+        CHUNK_BLOCKS = 8 ///< ...but at least this many blocks
+    };
+
+    struct Stats {
+        size_t pooled; ///< allocations served from a free list
+        size_t heap; ///< allocations that had to go to the heap
+        size_t in_use; ///< blocks currently handed out
+    };
+
+    static void *allocate(size_t size);
+    /// @param size must be the size given to allocate()
+    static void deallocate(void *block, size_t size);
+
+    static const Stats &stats();
+};
+
+/**
+   Base class for objects that should be allocated from the MemoryPool.
+   Classes using it must have a virtual destructor if they are deleted
+   through a base class pointer, so the right size is given back.
+ */
+class PoolAllocated {
+public:
+    static void *operator new(size_t size) { return MemoryPool::allocate(size); }
+    static void operator delete(void *block, size_t size) { MemoryPool::deallocate(block, size); }
+};
+
+/**
+   Allocator for standard containers whose nodes come and go as often as
+   the objects above, e.g. the std::map of a SignalTracker.
+ */
+template <typename T>
+class PoolAllocator {
+public:
+    typedef T value_type;
+
+    PoolAllocator() { }
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U> &) { }
+
+    T *allocate(size_t n) {
+        return static_cast<T *>(MemoryPool::allocate(n * sizeof(T)));
+    }
+    void deallocate(T *p, size_t n) {
+        MemoryPool::deallocate(p, n * sizeof(T));
+    }
+};
+
+template <typename T, typename U>
+bool operator ==(const PoolAllocator<T> &, const PoolAllocator<U> &) { return true; }
+template <typename T, typename U>
+bool operator !=(const PoolAllocator<T> &, const PoolAllocator<U> &) { return false; }
+
+} // end namespace FbTk
+
+#endif // FBTK_MEMORYPOOL_HH
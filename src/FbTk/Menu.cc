@@ -702,6 +702,10 @@ void Menu::drawSubmenu(unsigned int index) {
             item->submenu()->m_parent = this;
 
         item->submenu()->setScreen(m_screen.x, m_screen.y, m_screen.width, m_screen.height);
+        // submenus may postpone their layout while hidden, we need
+        // the real size to place it
+        if (item->submenu()->m_need_update)
+            item->submenu()->updateMenu();
 
         // ensure we do not divide by 0 and thus cause a SIGFPE
         if (m_rows_per_column == 0) {
@@ -811,6 +815,20 @@ void Menu::setLabel(const FbTk::BiDiString &labelstr) {
 }
 
 
+void Menu::updateItem(unsigned int index) {
+    if (!validIndex(index))
+        return;
+
+    if (!isVisible() || m_items[index]->width(theme()) > m_item_w) {
+        m_need_update = true;
+        if (isVisible())
+            updateMenu();
+        return;
+    }
+
+    clearItem(index);
+}
+
 void Menu::setItemSelected(unsigned int index, bool sel) {
     if (!validIndex(index)) {
         return;
@@ -106,6 +106,11 @@ public:
     void setLabel(const FbTk::BiDiString &labelstr);
     virtual void move(int x, int y);
     virtual void updateMenu();
+    /**
+       The label of item index changed. Redraws just that row while the
+       menu is shown, otherwise the menu is laid out on the next show().
+     */
+    void updateItem(unsigned int index);
     void setItemSelected(unsigned int index, bool val);
     void setItemEnabled(unsigned int index, bool val);
     void setMinimumColumns(int columns) { m_min_columns = columns; }
@@ -22,6 +22,8 @@
 #ifndef FBTK_REFCOUNT_HH
 #define FBTK_REFCOUNT_HH
 
+#include "MemoryPool.hh"
+
 namespace FbTk {
 
 /// holds a pointer with reference counting, similar to std:auto_ptr
@@ -49,6 +51,12 @@ private:
     void incRefCount();
     /// decrease reference count
     void decRefCount();
+    /// counters are tiny and there is one for every RefCount, so use the pool
+    static unsigned int *newRefCount() {
+        unsigned int *count = static_cast<unsigned int *>(MemoryPool::allocate(sizeof(unsigned int)));
+        *count = 0;
+        return count;
+    }
     Pointer *m_data; ///< data holder
     unsigned int *m_refcount; ///< holds reference counting
 
@@ -60,7 +68,7 @@ private:
 // implementation
 
 template <typename Pointer>
-RefCount<Pointer>::RefCount():m_data(0), m_refcount(new unsigned int(0)) {
+RefCount<Pointer>::RefCount():m_data(0), m_refcount(newRefCount()) {
     incRefCount(); // it really counts how many things are storing m_refcount
 }
 
@@ -73,7 +81,7 @@ RefCount<Pointer>::RefCount(const RefCount<Pointer2> &copy):
 }
 
 template <typename Pointer>
-RefCount<Pointer>::RefCount(Pointer *p):m_data(p), m_refcount(new unsigned int(0)) {
+RefCount<Pointer>::RefCount(Pointer *p):m_data(p), m_refcount(newRefCount()) {
     incRefCount();
 }
 
@@ -102,7 +110,7 @@ template <typename Pointer>
 void RefCount<Pointer>::reset(Pointer *p) {
     decRefCount();
     m_data = p; // set data pointer
-    m_refcount = new unsigned int(0); // create new counter
+    m_refcount = newRefCount(); // create new counter
     incRefCount();
 }
 
@@ -111,7 +119,7 @@ void RefCount<Pointer>::decRefCount() {
     if (m_refcount == 0)
         return;
     if (*m_refcount == 0) { // already zero, then delete refcount
-        delete m_refcount;
+        MemoryPool::deallocate(m_refcount, sizeof(unsigned int));
         m_refcount = 0;
         return;
     }
@@ -120,7 +128,7 @@ void RefCount<Pointer>::decRefCount() {
         if (m_data != 0)
             delete m_data;
         m_data = 0;
-        delete m_refcount;
+        MemoryPool::deallocate(m_refcount, sizeof(unsigned int));
         m_refcount = 0;
     }
 }
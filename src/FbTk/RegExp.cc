@@ -22,6 +22,7 @@
 
 #include "RegExp.hh"
 
+#include <cstring>
 #include <iostream>
 
 using std::string;
@@ -31,13 +32,38 @@ using std::cerr;
 using std::endl;
 #endif // USE_REGEXP
 
+namespace {
+
+#ifdef USE_REGEXP
+
+/// regexec results kept per expression before the cache starts over
+const size_t MAX_CACHED_MATCHES = 64;
+
+/// characters with a meaning for regcomp
+inline bool isSpecial(char c) {
+    return strchr(".[]()*+?{}|^$\\", c) != 0;
+}
+
+/// the number of backslashes right before pos
+size_t backslashesBefore(const string &str, size_t pos) {
+    size_t count = 0;
+    while (pos > count && str[pos - count - 1] == '\\')
+        ++count;
+    return count;
+}
+
+#endif // USE_REGEXP
+
+} // end anonymous namespace
+
 namespace FbTk {
 
 // full_match is to say if we match on this regexp using the full string
 // or just a substring. Substrings aren't supported if not HAVE_REGEXP
 RegExp::RegExp(const string &str, bool full_match):
 #ifdef USE_REGEXP
-m_regex(0) {
+m_regex(0),
+m_literal(NOT_LITERAL) {
     string match;
     if (full_match) {
         match = "^";
@@ -47,6 +73,10 @@ m_regex(0) {
         match = str;
     }
 
+    parseLiteral(match);
+    if (m_literal != NOT_LITERAL)
+        return;
+
     m_regex = new regex_t;
     int ret = regcomp(m_regex, match.c_str(), REG_NOSUB | REG_EXTENDED);
     if (ret != 0) {
@@ -67,12 +97,94 @@ RegExp::~RegExp() {
 #endif // USE_REGEXP
 }
 
-bool RegExp::match(const string &str) const {
 #ifdef USE_REGEXP
-    if (m_regex)
-        return regexec(m_regex, str.c_str(), 0, 0, 0) == 0;
+/*
+ * Most patterns are just a name like "xterm", maybe with a leading or
+ * trailing ".*". Those get matched with a string compare. Anything else,
+ * including escapes like \w which are extensions of regcomp, is left to
+ * the real thing.
+ */
+void RegExp::parseLiteral(const string &pattern) {
+    // regcomp would stop at a '\0'
+    if (pattern.empty() || pattern.find('\0') != string::npos)
+        return;
+
+    size_t begin = 0, end = pattern.size();
+    bool anchor_begin = false, anchor_end = false;
+
+    if (begin < end && pattern[begin] == '^') {
+        anchor_begin = true;
+        ++begin;
+    }
+    if (end - begin >= 2 && pattern.compare(begin, 2, ".*") == 0) {
+        anchor_begin = false;
+        begin += 2;
+    }
+    if (end > begin && pattern[end - 1] == '$' &&
+        backslashesBefore(pattern, end - 1) % 2 == 0) {
+        anchor_end = true;
+        --end;
+    }
+    if (end - begin >= 2 && pattern.compare(end - 2, 2, ".*") == 0 &&
+        backslashesBefore(pattern, end - 2) % 2 == 0) {
+        anchor_end = false;
+        end -= 2;
+    }
+
+    string text;
+    for (size_t i = begin; i < end; ++i) {
+        if (pattern[i] == '\\') {
+            if (++i == end || !isSpecial(pattern[i]))
+                return;
+        } else if (isSpecial(pattern[i]))
+            return;
+        text += pattern[i];
+    }
+
+    m_str = text;
+    if (anchor_begin && anchor_end)
+        m_literal = EXACT;
+    else if (anchor_begin)
+        m_literal = PREFIX;
+    else if (anchor_end)
+        m_literal = SUFFIX;
     else
+        m_literal = CONTAINS;
+}
+#endif // USE_REGEXP
+
+bool RegExp::match(const string &str) const {
+#ifdef USE_REGEXP
+    // regexec only sees the string up to the first '\0'
+    const char *s = str.c_str();
+    const size_t len = strlen(s);
+    const size_t n = m_str.size();
+
+    switch (m_literal) {
+    case EXACT:
+        return len == n && memcmp(s, m_str.data(), n) == 0;
+    case PREFIX:
+        return len >= n && memcmp(s, m_str.data(), n) == 0;
+    case SUFFIX:
+        return len >= n && memcmp(s + len - n, m_str.data(), n) == 0;
+    case CONTAINS:
+        return n == 0 || (len >= n && strstr(s, m_str.c_str()) != 0);
+    case NOT_LITERAL:
+        break;
+    }
+
+    if (m_regex == 0)
         return false;
+
+    std::map<string, bool>::const_iterator it = m_cache.find(str);
+    if (it != m_cache.end())
+        return it->second;
+
+    bool result = regexec(m_regex, s, 0, 0, 0) == 0;
+    if (m_cache.size() >= MAX_CACHED_MATCHES)
+        m_cache.clear();
+    m_cache[str] = result;
+    return result;
 #else // notdef USE_REGEXP
     return (m_str == str);
 #endif // USE_REGEXP
@@ -81,7 +193,7 @@ bool RegExp::match(const string &str) const {
 
 bool RegExp::error() const {
 #ifdef USE_REGEXP
-    return m_regex == 0;
+    return m_regex == 0 && m_literal == NOT_LITERAL;
 #else
     return m_str == "";
 #endif // USE_REGEXP
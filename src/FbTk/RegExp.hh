@@ -26,6 +26,7 @@
 
 #include "NotCopyable.hh"
 
+#include <map>
 #include <string>
 
 /*
@@ -50,10 +51,23 @@ public:
 
 private:
 #ifdef USE_REGEXP
+    /// patterns which are plain text are compared without regexec
+    enum Literal {
+        NOT_LITERAL,
+        EXACT,      ///< ^foo$
+        PREFIX,     ///< ^foo
+        SUFFIX,     ///< foo$
+        CONTAINS    ///< foo
+    };
+    /// sets m_literal and m_str if pattern is plain text
+    void parseLiteral(const std::string &pattern);
+
     regex_t* m_regex;
-#else // notdef USE_REGEXP
-    std::string m_str;
+    Literal m_literal;
+    /// results of regexec for recently matched strings
+    mutable std::map<std::string, bool> m_cache;
 #endif // USE_REGEXP
+    std::string m_str;
 
 };
 
@@ -24,8 +24,17 @@
 #include "I18n.hh"
 #include "StringUtil.hh"
 
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef HAVE_CSTDIO
+  #include <cstdio>
+#else
+  #include <stdio.h>
+#endif
 #include <iostream>
 #include <cassert>
+#include <cstdlib>
 
 using std::cerr;
 using std::endl;
@@ -102,7 +111,8 @@ bool ResourceManager::load(const char *filename) {
  Saves all the resource to a file
  @return 0 on success  else negative value representing the error
 */
-bool ResourceManager::save(const char *filename, const char *mergefilename) {
+bool ResourceManager::save(const char *filename, const char *mergefilename,
+                           const std::vector<std::string> *extra) {
     assert(filename);
 
     // these must be local variables; otherwise, the memory gets released by
@@ -114,22 +124,56 @@ bool ResourceManager::save(const char *filename, const char *mergefilename) {
         mergefilename = mergefile_str.c_str();
     }
 
-    // empty database
-    XrmDatabaseHelper database;
-
-    string rc_string;
+    string content;
     ResourceList::iterator i = m_resourcelist.begin();
     ResourceList::iterator i_end = m_resourcelist.end();
-    //write all resources to database
     for (; i != i_end; ++i) {
         Resource_base *resource = *i;
-        rc_string = resource->name() + string(": ") + resource->getString();
-        XrmPutLineResource(&*database, rc_string.c_str());
+        content += resource->name();
+        content += ": ";
+        content += resource->getString();
+        content += '\n';
+    }
+    if (extra) {
+        for (size_t l = 0; l < extra->size(); ++l) {
+            content += (*extra)[l];
+            content += '\n';
+        }
+    }
+
+    // nothing changed since we wrote the file ourselves
+    struct stat buf;
+    if (content == m_last_save.content && file_str == m_last_save.filename &&
+        stat(filename, &buf) == 0 &&
+        buf.st_mtime == m_last_save.mtime && buf.st_size == m_last_save.size)
+        return true;
+
+    // empty database
+    XrmDatabaseHelper database;
+
+    //write all resources to database
+    string::size_type start = 0, end;
+    while ((end = content.find('\n', start)) != string::npos) {
+        XrmPutLineResource(&*database, content.substr(start, end - start).c_str());
+        start = end + 1;
     }
 
     if (database==0)
         return false;
 
+    // write to a temporary file and rename it, so the file is never seen
+    // half written. rename the file a symlink points to, not the link,
+    // and keep the permissions of the file we replace
+    string target_str = file_str;
+    char *target = realpath(filename, 0);
+    if (target) {
+        target_str = target;
+        free(target);
+    }
+    string tmp_str = target_str + ".tmp";
+    struct stat target_stat;
+    const bool have_mode = stat(target_str.c_str(), &target_stat) == 0;
+
     //check if we want to merge a database
     if (mergefilename) {
         // force reload of file
@@ -146,40 +190,67 @@ bool ResourceManager::save(const char *filename, const char *mergefilename) {
         }
 
         XrmMergeDatabases(*database, &**m_database); // merge databases
-        XrmPutFileDatabase(**m_database, filename); // save database to file
+        XrmPutFileDatabase(**m_database, tmp_str.c_str()); // save database to file
 
         // don't try to destroy the database (XrmMergeDatabases destroys it)
         *database = 0;
         unlock();
     } else // save database to file
-        XrmPutFileDatabase(*database, filename);
+        XrmPutFileDatabase(*database, tmp_str.c_str());
+
+    if (have_mode)
+        chmod(tmp_str.c_str(), target_stat.st_mode & 07777);
+
+    if (rename(tmp_str.c_str(), target_str.c_str()) != 0) {
+        unlink(tmp_str.c_str());
+        return false;
+    }
 
     m_filename = filename;
+
+    m_last_save.filename = file_str;
+    m_last_save.content.swap(content);
+    if (stat(filename, &buf) == 0) {
+        m_last_save.mtime = buf.st_mtime;
+        m_last_save.size = buf.st_size;
+    }
     return true;
 }
 
-Resource_base *ResourceManager::findResource(const string &resname) {
-   // find resource name
-    ResourceList::iterator i = m_resourcelist.begin();
-    ResourceList::iterator i_end = m_resourcelist.end();
-    for (; i != i_end; ++i) {
-        if ((*i)->name() == resname ||
-            (*i)->altName() == resname)
-            return *i;
+void ResourceManager::indexResource(Resource_base &r) {
+    // like the linear search this replaces, the first one registered wins
+    m_index.insert(ResourceIndex::value_type(r.name(), &r));
+    m_index.insert(ResourceIndex::value_type(r.altName(), &r));
+}
+
+void ResourceManager::unindexResource(Resource_base &r) {
+    const string *names[] = { &r.name(), &r.altName() };
+    for (size_t n = 0; n < 2; ++n) {
+        ResourceIndex::iterator it = m_index.find(*names[n]);
+        if (it == m_index.end() || it->second != &r)
+            continue;
+        m_index.erase(it);
+
+        // another resource might use the same name
+        ResourceList::iterator i = m_resourcelist.begin();
+        ResourceList::iterator i_end = m_resourcelist.end();
+        for (; i != i_end; ++i) {
+            if ((*i)->name() == *names[n] || (*i)->altName() == *names[n]) {
+                m_index[*names[n]] = *i;
+                break;
+            }
+        }
     }
-    return 0;
+}
+
+Resource_base *ResourceManager::findResource(const string &resname) {
+    ResourceIndex::iterator it = m_index.find(resname);
+    return it == m_index.end() ? 0 : it->second;
 }
 
 const Resource_base *ResourceManager::findResource(const string &resname) const {
-   // find resource name
-    ResourceList::const_iterator i = m_resourcelist.begin();
-    ResourceList::const_iterator i_end = m_resourcelist.end();
-    for (; i != i_end; ++i) {
-        if ((*i)->name() == resname ||
-            (*i)->altName() == resname)
-            return *i;
-    }
-    return 0;
+    ResourceIndex::const_iterator it = m_index.find(resname);
+    return it == m_index.end() ? 0 : it->second;
 }
 
 string ResourceManager::resourceValue(const string &resname) const {
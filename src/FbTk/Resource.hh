@@ -26,8 +26,12 @@
 #include "Accessor.hh"
 #include "XrmDatabaseHelper.hh"
 
+#include <sys/types.h>
+
 #include <string>
 #include <list>
+#include <vector>
+#include <unordered_map>
 #include <iostream>
 #include <exception>
 #include <typeinfo>
@@ -89,8 +93,12 @@ public:
     virtual bool load(const char *filename);
 
     /// Save all resouces registered to this class
+    /// nothing is written if neither the resources nor the file
+    /// changed since the last save
+    /// @param extra additional "name: value" lines to store as well
     /// @return true on success
-    virtual bool save(const char *filename, const char *mergefilename=0);
+    virtual bool save(const char *filename, const char *mergefilename=0,
+                      const std::vector<std::string> *extra=0);
 
 
 
@@ -102,6 +110,7 @@ public:
     template <class T>
     void removeResource(Resource<T> &r) {
         m_resourcelist.remove(&r);
+        unindexResource(r);
     }
 
     /// searches for the resource with the resourcename
@@ -142,12 +151,26 @@ protected:
     int m_db_lock;
 
 private:
+    typedef std::unordered_map<std::string, Resource_base *> ResourceIndex;
+
+    void indexResource(Resource_base &r);
+    void unindexResource(Resource_base &r);
 
     ResourceList m_resourcelist;
+    ResourceIndex m_index; ///< name and altname -> first such resource
 
     XrmDatabaseHelper *m_database;
 
     std::string m_filename;
+
+    /// what the last save() wrote, to skip saves that wouldn't change anything
+    struct SaveState {
+        SaveState():mtime(0), size(0) { }
+        std::string filename;
+        std::string content;
+        time_t mtime;
+        off_t size;
+    } m_last_save;
 };
 
 
@@ -198,6 +221,7 @@ template <class T>
 void ResourceManager::addResource(Resource<T> &r) {
     m_resourcelist.push_back(&r);
     m_resourcelist.unique();
+    indexResource(r);
 
     // lock ensures that the database is loaded.
     lock();
@@ -23,20 +23,8 @@
 
 #include "FbWindow.hh"
 #include "App.hh"
-#include "GContext.hh"
-#include "FbPixmap.hh"
-
-#ifdef HAVE_CSTRING
-  #include <cstring>
-#else
-  #include <string.h>
-#endif
-
-#ifdef HAVE_CSTDLIB
-  #include <cstdlib>
-#else
-  #include <stdlib.h>
-#endif
+#include "FbTime.hh"
+#include "SimpleCommand.hh"
 
 #include <X11/Xutil.h>
 
@@ -46,126 +34,151 @@
 
 #include <algorithm>
 #include <vector>
-#include <iostream>
 
 using std::min;
+using std::max;
 
 namespace FbTk {
 
 namespace {
-/* rows is an array of 8 bytes, i.e. 8x8 bits */
-Pixmap makePixmap(Display* disp, int screen_nr, Window parent, const unsigned char rows[]) {
-
-    const size_t data_size = 8 * 8;
-    // we use malloc here so we get consistent C alloc/free with XDestroyImage
-    // and no warnings in valgrind :)
-    char *data = (char *)malloc(data_size * sizeof (char));
-    if (data == 0)
-        return 0;
-
-    memset(data, 0xFF, data_size);
-
-    XImage *ximage = XCreateImage(disp,
-                                  DefaultVisual(disp, screen_nr),
-                                  1,
-                                  XYPixmap, 0,
-                                  data,
-                                  8, 8,
-                                  32, 0);
-    if (ximage == 0) {
-        free(data);
-        return 0;
-    }
 
-    XInitImage(ximage);
+/// while resizing, don't reshape more often than this
+const uint64_t UPDATE_INTERVAL = 40 * FbTime::IN_MILLISECONDS;
 
-    for (int y=0; y<8; y++) {
-        for (int x=0; x<8; x++) {
-            XPutPixel(ximage, x, y, (rows[y] & (0x01 << x)) ? 0 : 1); // inverted, it is subtracted
-        }
-    }
-
-    FbPixmap pm(parent, 8, 8, 1);
-    GContext gc(pm);
+#ifdef SHAPE
 
-    XPutImage(disp, pm.drawable(), gc.gc(), ximage, 0, 0, 0, 0,
-              8, 8);
+/**
+   Number of pixels cut off each of the 8 rows of a round corner, starting
+   with the row at the edge of the window.
+ */
+const int s_corner_insets[8] = { 6, 3, 2, 1, 1, 1, 0, 0 };
+const int CORNER_SIZE = 8;
 
-    XDestroyImage(ximage);
+typedef std::vector<XRectangle> Rectangles;
 
-    return pm.release();
+void addRect(Rectangles &rects, int x, int y, int width, int height) {
+    if (width <= 0 || height <= 0)
+        return;
+    XRectangle rect;
+    rect.x = x;
+    rect.y = y;
+    rect.width = width;
+    rect.height = height;
+    rects.push_back(rect);
 }
 
-struct CornerPixmaps {
-    CornerPixmaps() : do_create(true) { }
-
-    FbPixmap topleft;
-    FbPixmap topright;
-    FbPixmap botleft;
-    FbPixmap botright;
-
-    bool do_create;
-};
-
-// unfortunately, we need a separate pixmap per screen
-std::vector<CornerPixmaps> s_corners;
-
-unsigned long nr_shapes = 0;
-
-void initCorners(int screen) {
-
-    Display* disp = App::instance()->display();
-    if (s_corners.empty())
-        s_corners.resize(ScreenCount(disp));
-
-
-    if (screen < 0 || screen > static_cast<int>(s_corners.size())) {
-        std::cerr << "FbTk/Shape.cc:initCorners(), invalid argument: " << screen << "\n";
-        return;
+/// pixels cut off at the left and right of row y of a height rows high area
+void rowInsets(int places, int y, int height, int &left, int &right) {
+    left = right = 0;
+    if (y < CORNER_SIZE) {
+        if (places & Shape::TOPLEFT)
+            left = s_corner_insets[y];
+        if (places & Shape::TOPRIGHT)
+            right = s_corner_insets[y];
     }
-
-    static const unsigned char left_bits[] = { 0xc0, 0xf8, 0xfc, 0xfe, 0xfe, 0xfe, 0xff, 0xff };
-    static const unsigned char right_bits[] = { 0x03, 0x1f, 0x3f, 0x7f, 0x7f, 0x7f, 0xff, 0xff};
-    static const unsigned char bottom_left_bits[] = { 0xff, 0xff, 0xfe, 0xfe, 0xfe, 0xfc, 0xf8, 0xc0 };
-    static const unsigned char bottom_right_bits[] = { 0xff, 0xff, 0x7f, 0x7f, 0x7f, 0x3f, 0x1f, 0x03 };
-
-    CornerPixmaps& corners = s_corners[screen];
-    if (corners.do_create) {
-
-        Window root = RootWindow(disp, screen);
-        corners.topleft = makePixmap(disp, screen, root, left_bits);
-        corners.topright = makePixmap(disp, screen, root, right_bits);
-        corners.botleft = makePixmap(disp, screen, root, bottom_left_bits);
-        corners.botright = makePixmap(disp, screen, root, bottom_right_bits);
-        corners.do_create = false;
+    const int bottom_y = height - 1 - y;
+    if (bottom_y < CORNER_SIZE) {
+        if (places & Shape::BOTTOMLEFT)
+            left = max(left, s_corner_insets[bottom_y]);
+        if (places & Shape::BOTTOMRIGHT)
+            right = max(right, s_corner_insets[bottom_y]);
     }
+}
 
-    nr_shapes++; // refcounting
+/**
+   Rectangles of the area (x, y, width, height) with round corners at the
+   given places. With keep == true these are the rectangles that remain,
+   in YX-banded order; otherwise the corner pixels that are cut off.
+ */
+void cornerRects(int places, int x, int y, int width, int height,
+                 bool keep, Rectangles &rects) {
+    int row = 0;
+    while (row < height) {
+        int left, right;
+        rowInsets(places, row, height, left, right);
+
+        // merge following rows with the same insets into one band, rows
+        // between the corners have none
+        int next = row;
+        for (;;) {
+            if (next >= CORNER_SIZE && next < height - CORNER_SIZE)
+                next = height - CORNER_SIZE;
+            else
+                ++next;
+            if (next >= height)
+                break;
+            int next_left, next_right;
+            rowInsets(places, next, height, next_left, next_right);
+            if (next_left != left || next_right != right)
+                break;
+        }
+        next = min(next, height);
+
+        if (keep) {
+            addRect(rects, x + left, y + row, width - left - right, next - row);
+        } else {
+            addRect(rects, x, y + row, min(left, width), next - row);
+            int right_x = max(width - right, 0);
+            addRect(rects, x + right_x, y + row, width - right_x, next - row);
+        }
+        row = next;
+    }
 }
 
-void cleanCorners() {
+/// rectangles covering outer but not inner
+void subtractRect(const XRectangle &outer, const XRectangle &inner, Rectangles &rects) {
+    const int ox2 = outer.x + outer.width, oy2 = outer.y + outer.height;
+    const int ix1 = max<int>(inner.x, outer.x), iy1 = max<int>(inner.y, outer.y);
+    const int ix2 = min<int>(inner.x + inner.width, ox2);
+    const int iy2 = min<int>(inner.y + inner.height, oy2);
 
-    if (nr_shapes == 1) {
-        s_corners.clear();
+    if (ix1 >= ix2 || iy1 >= iy2) {
+        addRect(rects, outer.x, outer.y, outer.width, outer.height);
+        return;
     }
 
-    if (nr_shapes > 0) {
-        nr_shapes--; // refcounting
-    }
+    addRect(rects, outer.x, outer.y, outer.width, iy1 - outer.y);
+    addRect(rects, outer.x, iy1, ix1 - outer.x, iy2 - iy1);
+    addRect(rects, ix2, iy1, ox2 - ix2, iy2 - iy1);
+    addRect(rects, outer.x, iy2, outer.width, oy2 - iy2);
+}
+
+void combineRects(Window win, int kind, Rectangles &rects, int op, int ordering) {
+    if (rects.empty() && op != ShapeSet)
+        return;
+    XShapeCombineRectangles(App::instance()->display(), win, kind, 0, 0,
+                            rects.empty() ? 0 : &rects[0], rects.size(),
+                            op, ordering);
 }
+#endif // SHAPE
 
 } // end of anonymous namespace
 
+bool Shape::State::operator == (const State &other) const {
+    return valid == other.valid &&
+        width == other.width && height == other.height &&
+        border_width == other.border_width && places == other.places &&
+        source == other.source &&
+        source_x == other.source_x && source_y == other.source_y &&
+        source_width == other.source_width &&
+        source_height == other.source_height;
+}
+
 Shape::Shape(FbWindow &win, int shapeplaces):
     m_win(&win),
     m_shapesource(0),
     m_shapesource_xoff(0),
     m_shapesource_yoff(0),
-    m_shapeplaces(shapeplaces) {
+    m_shapeplaces(shapeplaces),
+    m_force_update(false),
+    m_last_update(0) {
 
-#ifdef SHAPE
-    initCorners(win.screenNumber());
-#endif
+    m_applied.valid = false;
+
+    RefCount<Command<void> > apply(new SimpleCommand<Shape>(*this, &Shape::apply));
+    m_timer.setCommand(apply);
+    m_timer.setTimeout(UPDATE_INTERVAL);
+    m_timer.fireOnce(true);
 
     update();
 }
@@ -188,8 +201,6 @@ Shape::~Shape() {
                           0,
                           ShapeSet);
     }
-
-    cleanCorners();
 #endif // SHAPE
 }
 
@@ -197,144 +208,154 @@ void Shape::setPlaces(int shapeplaces) {
     m_shapeplaces = shapeplaces;
 }
 
+Shape::State Shape::currentState() const {
+    State state;
+    state.valid = true;
+    state.width = m_win->width();
+    state.height = m_win->height();
+    state.border_width = m_win->borderWidth();
+    state.places = m_shapeplaces;
+    state.source = m_shapesource ? m_shapesource->window() : None;
+    state.source_x = m_shapesource_xoff;
+    state.source_y = m_shapesource_yoff;
+    state.source_width = m_shapesource ? m_shapesource->width() : 0;
+    state.source_height = m_shapesource ? m_shapesource->height() : 0;
+    return state;
+}
+
 void Shape::update() {
     if (m_win == 0 || m_win->window() == 0)
         return;
 
 #ifdef SHAPE
+    // frames call this on every reconfigure, most of them don't change
+    // anything we care about
+    if (!m_force_update && currentState() == m_applied)
+        return;
+
+    // a resize burst (opaque resizing) gets reshaped at most every
+    // UPDATE_INTERVAL, the timer applies whatever the last state was
+    if (!m_force_update &&
+        FbTime::mono() - m_last_update < UPDATE_INTERVAL) {
+        m_timer.start();
+        return;
+    }
+
+    apply();
+#endif // SHAPE
+}
+
+void Shape::apply() {
+    m_timer.stop();
+
+    if (m_win == 0 || m_win->window() == 0)
+        return;
+
+#ifdef SHAPE
+    const State state = currentState();
+    if (!m_force_update && state == m_applied)
+        return;
+
+    m_applied = state;
+    m_force_update = false;
+    m_last_update = FbTime::mono();
+
     /**
      * Set the client's shape in position,
      * or wipe the shape and return.
      */
     Display *display = App::instance()->display();
-    int bw = m_win->borderWidth();
-    int width = m_win->width();
-    int height = m_win->height();
+    Window win = m_win->window();
+    const int bw = state.border_width;
+    const int width = state.width;
+    const int height = state.height;
 
     if (m_shapesource == 0 && m_shapeplaces == 0) {
         /* clear the shape and return */
         XShapeCombineMask(display,
-                          m_win->window(), ShapeClip,
+                          win, ShapeClip,
                           0, 0,
                           None, ShapeSet);
         XShapeCombineMask(display,
-                          m_win->window(), ShapeBounding,
+                          win, ShapeBounding,
                           0, 0,
                           None, ShapeSet);
         return;
     }
 
-    Region clip = XCreateRegion();
-    Region bound = XCreateRegion();
+    Rectangles rects;
 
-    XRectangle rect;
-    rect.x = 0;
-    rect.y = 0;
-    rect.width = width;
-    rect.height = height;
+    if (m_shapesource == 0) {
+        // the whole shape, corners included, in one request per kind
+        cornerRects(m_shapeplaces, 0, 0, width, height, true, rects);
+        combineRects(win, ShapeClip, rects, ShapeSet, YXBanded);
 
-    XUnionRectWithRegion(&rect, clip, clip);
-
-    rect.x = -bw;
-    rect.y = -bw;
-    rect.width = width+2*bw;
-    rect.height = height+2*bw;
-
-    XUnionRectWithRegion(&rect, bound, bound);
-
-    if (m_shapesource != 0) {
-
-        /*
-          Copy the shape from the source.
-          We achieve this by subtracting the client-area size from the shape, and then
-          unioning in the client's mask.
-        */
-        rect.x = m_shapesource_xoff;
-        rect.y = m_shapesource_yoff;
-        rect.width = m_shapesource->width();
-        rect.height = m_shapesource->height();
-
-        Region clientarea = XCreateRegion();
-        XUnionRectWithRegion(&rect, clientarea, clientarea);
-        XSubtractRegion(clip, clientarea, clip);
-        XSubtractRegion(bound, clientarea, bound);
-        XDestroyRegion(clientarea);
-
-        XShapeCombineShape(display,
-                           m_win->window(), ShapeClip,
-                           rect.x, rect.y, // xOff, yOff
-                           m_shapesource->window(),
-                           ShapeClip, ShapeSet);
-
-        XShapeCombineRegion(display,
-                            m_win->window(), ShapeClip,
-                            0, 0, // offsets
-                            clip, ShapeUnion);
-
-        /* 
-           Now the bounding rectangle. Note that the frame has a shared border with the region above the 
-           client (i.e. titlebar), so we don't want to wipe the shared border, hence the adjustments.
-        */
-
-        XShapeCombineShape(display,
-                           m_win->window(), ShapeBounding,
-                           rect.x, rect.y, // xOff, yOff
-                           m_shapesource->window(),
-                           ShapeBounding, ShapeSet);
-
-        XShapeCombineRegion(display,
-                            m_win->window(), ShapeBounding,
-                            0, 0, // offsets
-                            bound, ShapeUnion);
-    } else {
-        XShapeCombineRegion(display,
-                            m_win->window(), ShapeClip,
-                            0, 0, // offsets
-                            clip, ShapeSet);
-        XShapeCombineRegion(display,
-                            m_win->window(), ShapeBounding,
-                            0, 0, // offsets
-                            bound, ShapeSet);
+        rects.clear();
+        cornerRects(m_shapeplaces, -bw, -bw, width + 2*bw, height + 2*bw, true, rects);
+        combineRects(win, ShapeBounding, rects, ShapeSet, YXBanded);
+        return;
     }
 
-    XDestroyRegion(clip);
-    XDestroyRegion(bound);
-
-   const CornerPixmaps &corners = s_corners[m_win->screenNumber()];
-#define SHAPECORNER(corner, x, y, shapekind)            \
-    XShapeCombineMask(App::instance()->display(), \
-                      m_win->window(),                  \
-                      shapekind,                        \
-                      x, y,                             \
-                      corners.corner.drawable(),      \
-                      ShapeSubtract); 
+    /*
+      Copy the shape from the source.
+      We achieve this by taking the client's shape and then unioning in
+      everything of the frame outside the client-area.
+    */
+    XRectangle clientarea;
+    clientarea.x = m_shapesource_xoff;
+    clientarea.y = m_shapesource_yoff;
+    clientarea.width = state.source_width;
+    clientarea.height = state.source_height;
+
+    XRectangle clip;
+    clip.x = 0;
+    clip.y = 0;
+    clip.width = width;
+    clip.height = height;
+
+    /*
+       The bounding rectangle. Note that the frame has a shared border with the region above the
+       client (i.e. titlebar), so we don't want to wipe the shared border, hence the adjustments.
+    */
+    XRectangle bound;
+    bound.x = -bw;
+    bound.y = -bw;
+    bound.width = width + 2*bw;
+    bound.height = height + 2*bw;
 
     /**
-     * Set the top corners if the y offset is nonzero.
+     * Set the top corners if the y offset is nonzero, the bottom ones if
+     * the client doesn't reach the bottom.
      */
-    if (m_shapesource == 0 || m_shapesource_yoff != 0) {
-        if (m_shapeplaces & TOPLEFT) {
-            SHAPECORNER(topleft, 0, 0, ShapeClip);
-            SHAPECORNER(topleft, -bw, -bw, ShapeBounding);
-        }
-        if (m_shapeplaces & TOPRIGHT) {
-            SHAPECORNER(topright, width-8, 0, ShapeClip);
-            SHAPECORNER(topright, width+bw-8, -bw, ShapeBounding);
-        }
-    }
-
-    // note that the bottom corners y-vals are offset by 8 (the height of the corner pixmaps)
-    if (m_shapesource == 0 || (m_shapesource_yoff+(signed) m_shapesource->height()) < height
-        || m_shapesource_yoff >= height /* shaded */) {
-        if (m_shapeplaces & BOTTOMLEFT) {
-            SHAPECORNER(botleft, 0, height-8, ShapeClip);
-            SHAPECORNER(botleft, -bw, height+bw-8, ShapeBounding);
-        }
-        if (m_shapeplaces & BOTTOMRIGHT) {
-            SHAPECORNER(botright, width-8, height-8, ShapeClip);
-            SHAPECORNER(botright, width+bw-8, height+bw-8, ShapeBounding);
-        }
-    }
+    int places = m_shapeplaces;
+    if (m_shapesource_yoff == 0)
+        places &= ~(TOPLEFT | TOPRIGHT);
+    if (!((m_shapesource_yoff + static_cast<int>(state.source_height)) < height
+          || m_shapesource_yoff >= height /* shaded */))
+        places &= ~(BOTTOMLEFT | BOTTOMRIGHT);
+
+    XShapeCombineShape(display,
+                       win, ShapeClip,
+                       clientarea.x, clientarea.y, // xOff, yOff
+                       m_shapesource->window(),
+                       ShapeClip, ShapeSet);
+    subtractRect(clip, clientarea, rects);
+    combineRects(win, ShapeClip, rects, ShapeUnion, Unsorted);
+    rects.clear();
+    cornerRects(places, 0, 0, width, height, false, rects);
+    combineRects(win, ShapeClip, rects, ShapeSubtract, Unsorted);
+
+    XShapeCombineShape(display,
+                       win, ShapeBounding,
+                       clientarea.x, clientarea.y, // xOff, yOff
+                       m_shapesource->window(),
+                       ShapeBounding, ShapeSet);
+    rects.clear();
+    subtractRect(bound, clientarea, rects);
+    combineRects(win, ShapeBounding, rects, ShapeUnion, Unsorted);
+    rects.clear();
+    cornerRects(places, -bw, -bw, width + 2*bw, height + 2*bw, false, rects);
+    combineRects(win, ShapeBounding, rects, ShapeSubtract, Unsorted);
 
 #endif // SHAPE
 
@@ -342,6 +363,7 @@ void Shape::update() {
 
 void Shape::setWindow(FbWindow &win) {
     m_win = &win;
+    m_force_update = true;
     update();
 }
 
@@ -371,6 +393,7 @@ void Shape::setShapeSource(FbWindow *win, int xoff, int yoff, bool always_update
     m_shapesource = win;
     m_shapesource_xoff = xoff;
     m_shapesource_yoff = yoff;
+    m_force_update = true;
     update();
 }
 
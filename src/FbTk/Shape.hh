@@ -23,6 +23,9 @@
 #define SHAPE_HH
 
 #include "FbPixmap.hh"
+#include "Timer.hh"
+
+#include <X11/Xlib.h>
 
 namespace FbTk {
 class FbWindow;
@@ -42,8 +45,8 @@ public:
     ~Shape();
     /// set new shape places
     void setPlaces(int shapeplaces);
-    /// update our shape
-    void update(); 
+    /// update our shape, does nothing if nothing changed since last time
+    void update();
     /// assign a new window
     void setWindow(FbWindow &win);
     /// Assign a window to merge our shape with.
@@ -59,11 +62,31 @@ public:
     /// @return true if window has shape
     static bool isShaped(const FbWindow &win);
 private:
+    /// everything the shape depends on
+    struct State {
+        bool operator == (const State &other) const;
+        bool valid;
+        unsigned int width, height, border_width;
+        int places;
+        Window source;
+        int source_x, source_y;
+        unsigned int source_width, source_height;
+    };
+
+    State currentState() const;
+    /// send the shape to the server
+    void apply();
+
     FbWindow *m_win; ///< window to be shaped
     FbWindow *m_shapesource; ///< window to pull shape from
     int m_shapesource_xoff, m_shapesource_yoff;
 
     int m_shapeplaces; ///< places to shape
+
+    State m_applied; ///< state of the last shape sent to the server
+    bool m_force_update; ///< the source shape changed, update even if m_applied matches
+    uint64_t m_last_update; ///< time of the last apply()
+    Timer m_timer; ///< applies the last of a burst of updates
 };
 
 } // end namespace FbTk
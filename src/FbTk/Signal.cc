@@ -0,0 +1,66 @@
+// Signal.cc for FbTk - Fluxbox Toolkit
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "Signal.hh"
+
+namespace FbTk {
+
+namespace SigImpl {
+
+namespace {
+
+/// connections are carved from chunks of this many
+const size_t CHUNK_SIZE = 64;
+
+// The pool only ever grows. Signals live as long as the objects they
+// belong to, so it settles at the number of connections the program
+// has at its busiest.
+Connection *s_free_connections = 0;
+
+} // end anonymous namespace
+
+Connection *Connection::get() {
+    if (s_free_connections == 0) {
+        Connection *chunk = new Connection[CHUNK_SIZE];
+        for (size_t i = 0; i < CHUNK_SIZE; ++i) {
+            chunk[i].generation = 0;
+            release(&chunk[i]);
+        }
+    }
+
+    Connection *connection = s_free_connections;
+    s_free_connections = connection->next;
+    return connection;
+}
+
+void Connection::release(Connection *connection) {
+    ++connection->generation;
+    connection->signal = 0;
+    connection->slot = 0;
+    connection->tracker = 0;
+    connection->next = s_free_connections;
+    s_free_connections = connection;
+}
+
+} // namespace SigImpl
+
+} // namespace FbTk
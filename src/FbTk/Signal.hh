@@ -22,28 +22,81 @@
 #ifndef FBTK_SIGNAL_HH
 #define FBTK_SIGNAL_HH
 
+#include "NotCopyable.hh"
 #include "RefCount.hh"
 #include "Slot.hh"
-#include <algorithm>
-#include <list>
+#include "MemoryPool.hh"
+
+#include <utility>
 #include <map>
-#include <set>
 
 namespace FbTk {
 
 /// \namespace Implementation details for signals, do not use anything in this namespace
 namespace SigImpl {
 
+class SignalHolder;
+
+/**
+ * One slot connected to a signal. Connections are pooled and never given
+ * back to the heap, so a stale handle can always be checked against the
+ * generation, which changes each time the connection is released.
+ */
+struct Connection {
+    Connection *prev;
+    Connection *next;
+    const SignalHolder *signal;
+    SlotBase *slot;
+    void *tracker; ///< SignalHolder::Tracker to tell when the signal dies
+    unsigned int generation;
+    bool dead; ///< disconnected during emit, released afterwards
+
+    static Connection *get();
+    static void release(Connection *connection);
+};
+
+/// Handle for a connection, stays safe to use after disconnect.
+struct SlotHandle {
+    SlotHandle(): connection(0), generation(0) { }
+    SlotHandle(Connection *c): connection(c), generation(c->generation) { }
+
+    Connection *connection;
+    unsigned int generation;
+};
+
+/// Calls a reference counted slot, for Signal::connectSlot.
+template <typename SlotType>
+struct RefSlot {
+    explicit RefSlot(const RefCount<SlotType> &s): slot(s) { }
+
+    void operator()() { (*slot)(); }
+
+    template <typename A1>
+    void operator()(A1 &&a1) { (*slot)(std::forward<A1>(a1)); }
+
+    template <typename A1, typename A2>
+    void operator()(A1 &&a1, A2 &&a2) {
+        (*slot)(std::forward<A1>(a1), std::forward<A2>(a2));
+    }
+
+    template <typename A1, typename A2, typename A3>
+    void operator()(A1 &&a1, A2 &&a2, A3 &&a3) {
+        (*slot)(std::forward<A1>(a1), std::forward<A2>(a2), std::forward<A3>(a3));
+    }
+
+    RefCount<SlotType> slot;
+};
+
 /**
  * Parent class for all \c Signal template classes.
  * It handles the disconnect and holds all the slots. The connect must be
  * handled by the child class so it can do the type checking.
+ *
+ * The slots form a linked list of pooled connections, in the order they
+ * were connected. Slots disconnected during emit() are only marked and
+ * released when the outermost emit() is done.
  */
-class SignalHolder {
-protected:
-    typedef RefCount<SlotBase> SlotPtr;
-    typedef std::list<SlotPtr> SlotList;
-
+class SignalHolder: private NotCopyable {
 public:
     /// Special tracker interface used by SignalTracker.
     class Tracker {
@@ -53,72 +106,117 @@ public:
         virtual void disconnect(SignalHolder& signal) = 0;
     };
 
-    typedef SlotList::iterator Iterator;
-    typedef Iterator SlotID;
-    typedef SlotList::const_iterator ConstIterator;
+    typedef SlotHandle SlotID;
 
-    SignalHolder() : m_emitting(0) {}
+    SignalHolder(): m_first(0), m_last(0), m_emitting(0), m_dead(false) {}
 
     ~SignalHolder() {
         // Disconnect this holder from all trackers.
-        for (Trackers::iterator it = m_trackers.begin(),
-                 it_end = m_trackers.end();
-             it != it_end; ++it ) {
-            (*it)->disconnect(*this);
+        for (Connection *c = m_first; c != 0; c = c->next) {
+            if (c->tracker != 0 && !c->dead)
+                static_cast<Tracker *>(c->tracker)->disconnect(*this);
         }
+        while (m_first != 0)
+            release(m_first);
     }
 
     /// Remove a specific slot \c id from this signal
-    void disconnect(SlotID slotIt) const {
-        if(m_emitting) {
-            // if we are emitting, we must not erase the actual element, as that would
-            // invalidate iterators in the emit() function
-            *slotIt = SlotPtr();
+    void disconnect(SlotID id) const {
+        Connection *c = id.connection;
+        if (c == 0 || c->generation != id.generation || c->signal != this || c->dead)
+            return;
+
+        if (m_emitting) {
+            // emit() may be running this slot, or be about to go on
+            // to the next, so keep it around until emit() is done
+            markDead(c);
         } else
-            m_slots.erase( slotIt );
+            release(c);
     }
 
-
     /// Removes all slots connected to this
     void clear() {
-        if(m_emitting)
-            std::fill(m_slots.begin(), m_slots.end(), SlotPtr());
-        else
-            m_slots.clear();
-    }
-
-    void connectTracker(SignalHolder::Tracker& tracker) const {
-        m_trackers.insert(&tracker);
+        if (m_emitting) {
+            for (Connection *c = m_first; c != 0; c = c->next)
+                markDead(c);
+        } else {
+            while (m_first != 0)
+                release(m_first);
+        }
     }
 
-    void disconnectTracker(SignalHolder::Tracker& tracker) const {
-        m_trackers.erase(&tracker);
+    /// Tell tracker when this signal dies, as long as slot id is connected.
+    void connectTracker(SlotID id, SignalHolder::Tracker& tracker) const {
+        Connection *c = id.connection;
+        if (c != 0 && c->generation == id.generation && c->signal == this)
+            c->tracker = &tracker;
     }
 
 protected:
-    ConstIterator begin() const { return m_slots.begin(); }
-    ConstIterator end() const { return m_slots.end(); }
-
-    Iterator begin() { return m_slots.begin(); }
-    Iterator end() { return m_slots.end(); }
+    Connection *first() const { return m_first; }
 
     /// Connect a slot to this signal. Must only be called by child classes.
-    SlotID connect(const SlotPtr& slot) const {
-        return m_slots.insert(m_slots.end(), slot);
+    template <typename SlotType, typename Functor>
+    SlotID connect(const Functor &functor) const {
+        SlotBase *slot = new SlotType(functor);
+
+        Connection *c = Connection::get();
+        c->signal = this;
+        c->slot = slot;
+        c->tracker = 0;
+        c->dead = false;
+        c->next = 0;
+        c->prev = m_last;
+        if (m_last != 0)
+            m_last->next = c;
+        else
+            m_first = c;
+        m_last = c;
+        return SlotID(c);
     }
 
     void begin_emitting() { ++m_emitting; }
     void end_emitting() {
-        if(--m_emitting == 0) {
-            // remove elements which belonged slots that detached themselves
-            m_slots.erase(std::remove(m_slots.begin(), m_slots.end(), SlotPtr()), m_slots.end());
+        if (--m_emitting == 0 && m_dead) {
+            // release slots that were disconnected during emit
+            m_dead = false;
+            for (Connection *c = m_first, *next = 0; c != 0; c = next) {
+                next = c->next;
+                if (c->dead)
+                    release(c);
+            }
         }
     }
+
 private:
-    typedef std::set<Tracker*> Trackers;
-    mutable SlotList m_slots; ///< all slots connected to a signal
-    mutable Trackers m_trackers; ///< all instances that tracks this signal.
+    void markDead(Connection *c) const {
+        if (c->dead)
+            return;
+        c->dead = true;
+        c->tracker = 0;
+        // handles to it are invalid from now on
+        ++c->generation;
+        m_dead = true;
+    }
+
+    void release(Connection *c) const {
+        if (c->prev != 0)
+            c->prev->next = c->next;
+        else
+            m_first = c->next;
+        if (c->next != 0)
+            c->next->prev = c->prev;
+        else
+            m_last = c->prev;
+
+        delete c->slot;
+        Connection::release(c);
+    }
+
+    mutable Connection *m_first; ///< all slots connected to a signal
+    mutable Connection *m_last;
     unsigned m_emitting;
+    mutable bool m_dead; ///< slots were disconnected during emit
 };
 
 } // namespace SigImpl
@@ -130,22 +228,20 @@ class Signal: public SigImpl::SignalHolder {
 public:
     void emit(Arg1 arg1, Arg2 arg2, Arg3 arg3) {
         begin_emitting();
-        for ( Iterator it = begin(); it != end(); ++it ) {
-            if(*it)
-                static_cast<Slot<void, Arg1, Arg2, Arg3> &>(**it)(arg1, arg2, arg3);
+        for (SigImpl::Connection *c = first(); c != 0; c = c->next) {
+            if (!c->dead)
+                static_cast<Slot<void, Arg1, Arg2, Arg3> &>(*c->slot)(arg1, arg2, arg3);
         }
         end_emitting();
     }
 
     template<typename Functor>
     SlotID connect(const Functor& functor) const {
-        return SignalHolder::connect(SlotPtr(
-                        new SlotImpl<Functor, void, Arg1, Arg2, Arg3>(functor)
-                    ));
+        return SignalHolder::connect<SlotImpl<Functor, void, Arg1, Arg2, Arg3> >(functor);
     }
 
     SlotID connectSlot(const RefCount<FbTk::Slot<void, Arg1, Arg2, Arg3> > &slot) const {
-        return SignalHolder::connect(slot);
+        return connect(SigImpl::RefSlot<FbTk::Slot<void, Arg1, Arg2, Arg3> >(slot));
     }
 };
 
@@ -155,22 +251,20 @@ class Signal<Arg1, Arg2, SigImpl::EmptyArg>: public SigImpl::SignalHolder {
 public:
     void emit(Arg1 arg1, Arg2 arg2) {
         begin_emitting();
-        for ( Iterator it = begin(); it != end(); ++it ) {
-            if(*it)
-                static_cast<Slot<void, Arg1, Arg2> &>(**it)(arg1, arg2);
+        for (SigImpl::Connection *c = first(); c != 0; c = c->next) {
+            if (!c->dead)
+                static_cast<Slot<void, Arg1, Arg2> &>(*c->slot)(arg1, arg2);
         }
         end_emitting();
     }
 
     template<typename Functor>
     SlotID connect(const Functor& functor) const {
-        return SignalHolder::connect(SlotPtr(
-                        new SlotImpl<Functor, void, Arg1, Arg2>(functor)
-                    ));
+        return SignalHolder::connect<SlotImpl<Functor, void, Arg1, Arg2> >(functor);
     }
 
     SlotID connectSlot(const RefCount<FbTk::Slot<void, Arg1, Arg2> > &slot) const {
-        return SignalHolder::connect(slot);
+        return connect(SigImpl::RefSlot<FbTk::Slot<void, Arg1, Arg2> >(slot));
     }
 };
 
@@ -180,22 +274,20 @@ class Signal<Arg1, SigImpl::EmptyArg, SigImpl::EmptyArg>: public SigImpl::Signal
 public:
     void emit(Arg1 arg) {
         begin_emitting();
-        for ( Iterator it = begin(); it != end(); ++it ) {
-            if(*it)
-                static_cast<Slot<void, Arg1> &>(**it)(arg);
+        for (SigImpl::Connection *c = first(); c != 0; c = c->next) {
+            if (!c->dead)
+                static_cast<Slot<void, Arg1> &>(*c->slot)(arg);
         }
         end_emitting();
     }
 
     template<typename Functor>
     SlotID connect(const Functor& functor) const {
-        return SignalHolder::connect(SlotPtr(
-                        new SlotImpl<Functor, void, Arg1>(functor)
-                    ));
+        return SignalHolder::connect<SlotImpl<Functor, void, Arg1> >(functor);
     }
 
     SlotID connectSlot(const RefCount<FbTk::Slot<void, Arg1> > &slot) const {
-        return SignalHolder::connect(slot);
+        return connect(SigImpl::RefSlot<FbTk::Slot<void, Arg1> >(slot));
     }
 };
 
@@ -205,22 +297,20 @@ class Signal<SigImpl::EmptyArg, SigImpl::EmptyArg, SigImpl::EmptyArg>: public Si
 public:
     void emit() {
         begin_emitting();
-        for ( Iterator it = begin(); it != end(); ++it ) {
-            if(*it)
-                static_cast<Slot<void> &>(**it)();
+        for (SigImpl::Connection *c = first(); c != 0; c = c->next) {
+            if (!c->dead)
+                static_cast<Slot<void> &>(*c->slot)();
         }
         end_emitting();
     }
 
     template<typename Functor>
     SlotID connect(const Functor& functor) const {
-        return SignalHolder::connect(SlotPtr(
-                        new SlotImpl<Functor, void>(functor)
-                    ));
+        return SignalHolder::connect<SlotImpl<Functor, void> >(functor);
     }
 
     SlotID connectSlot(const RefCount<FbTk::Slot<void> > &slot) const {
-        return SignalHolder::connect(slot);
+        return connect(SigImpl::RefSlot<FbTk::Slot<void> >(slot));
     }
 };
 
@@ -230,10 +320,11 @@ public:
  */
 class SignalTracker: public SigImpl::SignalHolder::Tracker {
 public:
+    typedef const SigImpl::SignalHolder *TrackID; ///< \c ID type for join/leave.
     /// Internal type, do not use.
-    typedef std::map<const SigImpl::SignalHolder*,
-                     SigImpl::SignalHolder::SlotID> Connections;
-    typedef Connections::iterator TrackID; ///< \c ID type for join/leave.
+    typedef std::map<TrackID, SigImpl::SignalHolder::SlotID, std::less<TrackID>,
+                     PoolAllocator<std::pair<const TrackID,
+                                             SigImpl::SignalHolder::SlotID> > > Connections;
 
     ~SignalTracker() {
         leaveAll();
@@ -243,55 +334,48 @@ public:
     /// @return A tracking ID
     template<typename Arg1, typename Arg2, typename Arg3, typename Functor>
     TrackID join(const Signal<Arg1, Arg2, Arg3> &sig, const Functor &functor) {
-        return joinSlot(sig, RefCount<Slot<void, Arg1, Arg2, Arg3> >(
-                    new SlotImpl<Functor, void, Arg1, Arg2, Arg3>(functor)
-                    ));
+        // a signal is only tracked once
+        if (m_connections.find(&sig) != m_connections.end())
+            return &sig;
+
+        SigImpl::SignalHolder::SlotID id = sig.connect(functor);
+        sig.connectTracker(id, *this);
+        m_connections.insert(Connections::value_type(&sig, id));
+        return &sig;
     }
 
     template<typename Arg1, typename Arg2, typename Arg3>
     TrackID
     joinSlot(const Signal<Arg1, Arg2, Arg3> &sig,
             const RefCount<Slot<void, Arg1, Arg2, Arg3> > &slot) {
-
-        ValueType value = ValueType(&sig, sig.connectSlot(slot));
-        std::pair<TrackID, bool> ret = m_connections.insert(value);
-        if ( !ret.second ) {
-            // failed to insert this functor
-            sig.disconnect(value.second);
-        }
-
-        sig.connectTracker(*this);
-
-        return ret.first;
+        return join(sig, SigImpl::RefSlot<Slot<void, Arg1, Arg2, Arg3> >(slot));
     }
 
     /// Leave tracking for a signal
-    /// @param id the \c id from the previous \c join 
-   void leave(TrackID id) {
-       // keep temporary, while disconnecting we can
-       // in some strange cases get a call to this again
-        ValueType tmp = *id;
-        m_connections.erase(id);
+    /// @param id the \c id from the previous \c join
+    void leave(TrackID id) {
+        Iterator it = m_connections.find(id);
+        if (it == m_connections.end())
+            return;
+
+        // keep temporary, while disconnecting we can
+        // in some strange cases get a call to this again
+        Connections::value_type tmp = *it;
+        m_connections.erase(it);
         tmp.first->disconnect(tmp.second);
-        tmp.first->disconnectTracker(*this);
     }
 
     /// Leave tracking for a signal
     /// @param sig the signal to leave
     template <typename Signal>
     void leave(Signal &sig) {
-        Iterator it = m_connections.find(&sig);
-        if (it != m_connections.end()) {
-            leave(it);
-        }
+        leave(static_cast<TrackID>(&sig));
     }
 
-
     void leaveAll() {
         // disconnect all connections
-        for ( ; !m_connections.empty(); ) {
-            leave(m_connections.begin());
-        }
+        while (!m_connections.empty())
+            leave(m_connections.begin()->first);
     }
 
 protected:
@@ -301,9 +385,9 @@ protected:
     }
 
 private:
-    typedef Connections::value_type ValueType;
     typedef Connections::iterator Iterator;
-    /// holds all connections to different signals and slots.
+
+    /// holds all connections to different signals and slots, by signal.
     Connections m_connections;
 };
 
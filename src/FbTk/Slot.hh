@@ -22,6 +22,7 @@
 #ifndef FBTK_SLOT_HH
 #define FBTK_SLOT_HH
 
+#include "MemoryPool.hh"
 #include "NotCopyable.hh"
 
 namespace FbTk {
@@ -32,9 +33,10 @@ namespace SigImpl {
 struct EmptyArg {};
 
 /** A base class for all slots. It's purpose is to provide a virtual destructor and to enable the
- * Signal class to hold a pointer to a generic slot.
+ * Signal class to hold a pointer to a generic slot. Slots and commands are small and made for
+ * every window, so they come from the MemoryPool.
  */
-class SlotBase: private FbTk::NotCopyable {
+class SlotBase: public FbTk::PoolAllocated, private FbTk::NotCopyable {
 public:
     virtual ~SlotBase() {}
 };
@@ -24,6 +24,9 @@
 #include "Font.hh"
 #include "GContext.hh"
 
+#include <algorithm>
+#include <cstdlib>
+
 namespace FbTk {
 
 TextButton::TextButton(const FbTk::FbWindow &parent,
@@ -38,6 +41,9 @@ TextButton::TextButton(const FbTk::FbWindow &parent,
     m_left_padding(0),
     m_right_padding(0) {
 
+    m_text_area.x = m_text_area.y = 0;
+    m_text_area.width = m_text_area.height = 0;
+
     setRenderer(*this);
 }
 
@@ -68,11 +74,28 @@ bool TextButton::setOrientation(FbTk::Orientation orient) {
 }
 
 void TextButton::setText(const FbTk::BiDiString &text) {
-    if (m_text.logical() != text.logical()) {
-        m_text = text;
-        updateBackground(false);
+    if (m_text.logical() == text.logical())
+        return;
+
+    XRectangle old_area = m_text_area;
+    m_text_area.width = m_text_area.height = 0;
+
+    m_text = text;
+    updateBackground(false);
+
+    // the background only changed where the old and the new text are,
+    // unless the text isn't part of it or there was none to compare with
+    const XRectangle &area = m_text_area;
+    if (area.width == 0 || old_area.width == 0) {
         clear();
+        return;
     }
+
+    int x = std::min(area.x, old_area.x);
+    int y = std::min(area.y, old_area.y);
+    int right = std::max(area.x + area.width, old_area.x + old_area.width);
+    int bottom = std::max(area.y + area.height, old_area.y + old_area.height);
+    clearArea(x, y, right - x, bottom - y);
 }
 
 void TextButton::setFont(FbTk::Font &font) {
@@ -141,6 +164,7 @@ void TextButton::drawText(int x_offset, int y_offset, FbDrawable *drawable) {
 
     // text is to small to render
     if (n_pixels <= bevel()) {
+        m_text_area.width = m_text_area.height = 0;
         return;
     }
 
@@ -182,6 +206,21 @@ void TextButton::drawText(int x_offset, int y_offset, FbDrawable *drawable) {
 
     // TODO: remove debug output fprintf(stderr, "%d | %d %d %d\n", height(), font().height(), font().ascent(), font().descent());
 
+    // the columns the text covers, with some room for glyphs reaching
+    // past their advance
+    int overhang = font().ascent() / 4 + 1;
+    int area_x1 = std::max(0, baseline_x - overhang);
+    int text_width = font().textWidth(visual.data(), textlen);
+    int area_x2 = std::min(static_cast<int>(button_width),
+                           baseline_x + text_width + overhang);
+    int area_y1 = 0, area_y2 = button_height;
+    translateCoords(m_orientation, area_x1, area_y1, button_width, button_height);
+    translateCoords(m_orientation, area_x2, area_y2, button_width, button_height);
+    m_text_area.x = std::min(area_x1, area_x2);
+    m_text_area.y = std::min(area_y1, area_y2);
+    m_text_area.width = std::abs(area_x2 - area_x1);
+    m_text_area.height = std::abs(area_y2 - area_y1);
+
     // give it ROT0 style coords
     translateCoords(m_orientation, baseline_x, baseline_y, button_width, button_height);
 
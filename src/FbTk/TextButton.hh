@@ -78,6 +78,8 @@ private:
     int m_bevel;
     unsigned int m_left_padding; ///< space between buttonborder and text
     unsigned int m_right_padding; ///< space between buttonborder and text
+    /// where drawText last put the text, so setText only clears that
+    XRectangle m_text_area;
 
 };
 
@@ -93,6 +93,12 @@ public:
     const FbTk::FbPixmap &pixmap() const { return m_pixmap; }
     unsigned long type() const { return m_type; }
     bool usePixmap() const { return !( type() == (FLAT | SOLID) && pixmap().drawable() == 0); }
+    /// @return true if each row of the rendered texture has only one color
+    bool sameAlongRows() const {
+        return pixmap().drawable() == 0 &&
+            (type() & (PARENTRELATIVE | BEVEL1 | BEVEL2)) == 0 &&
+            ((type() & SOLID) || ((type() & GRADIENT) && (type() & VERTICAL)));
+    }
 
 private:
     FbTk::Color m_color, m_color_to, m_hicolor, m_locolor;
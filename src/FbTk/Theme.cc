@@ -34,14 +34,115 @@
 #else
   #include <stdio.h>
 #endif
+#ifdef HAVE_CSTRING
+  #include <cstring>
+#else
+  #include <string.h>
+#endif
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <memory>
 #include <iostream>
+#include <fstream>
 #include <algorithm>
 
 using std::cerr;
 using std::endl;
 using std::string;
 
+namespace {
+
+const char CACHE_MAGIC[8] = { 'F', 'B', 'S', 'T', 'Y', 'L', 'E', 1 };
+
+struct FileStamp {
+    FileStamp():mtime(0), size(0) { }
+    explicit FileStamp(const string &filename):mtime(0), size(0) {
+        struct stat buf;
+        if (!filename.empty() && stat(filename.c_str(), &buf) == 0) {
+            mtime = buf.st_mtime;
+            size = buf.st_size;
+        }
+    }
+    bool operator == (const FileStamp &other) const {
+        return mtime == other.mtime && size == other.size;
+    }
+
+    int64_t mtime;
+    int64_t size;
+};
+
+void writeInt(std::ostream &out, int64_t val) {
+    out.write(reinterpret_cast<const char *>(&val), sizeof(val));
+}
+
+void writeString(std::ostream &out, const string &str) {
+    writeInt(out, str.size());
+    out.write(str.data(), str.size());
+}
+
+bool readInt(std::istream &in, int64_t &val) {
+    return in.read(reinterpret_cast<char *>(&val), sizeof(val)).good();
+}
+
+bool readString(std::istream &in, string &str) {
+    int64_t size;
+    if (!readInt(in, size) || size < 0 || size > 0xffff)
+        return false;
+    str.resize(size);
+    return size == 0 || in.read(&str[0], size).good();
+}
+
+/// resources named *color / *colorTo hold colors
+bool isColorResource(const string &name) {
+    static const string COLOR("color"), COLORTO("colorto");
+    const string lower = FbTk::StringUtil::toLower(name);
+    return (lower.size() >= COLOR.size() &&
+            lower.compare(lower.size() - COLOR.size(), COLOR.size(), COLOR) == 0) ||
+           (lower.size() >= COLORTO.size() &&
+            lower.compare(lower.size() - COLORTO.size(), COLORTO.size(), COLORTO) == 0);
+}
+
+bool parseColor(const string &spec, XColor &color) {
+    string tmp(spec);
+    FbTk::StringUtil::removeFirstWhitespace(tmp);
+    FbTk::StringUtil::removeTrailingWhitespace(tmp);
+    Display *disp = FbTk::App::instance()->display();
+    return XParseColor(disp, DefaultColormap(disp, DefaultScreen(disp)),
+                       tmp.c_str(), &color) != 0;
+}
+
+/**
+   Resolve color names to their rgb values. XParseColor needs a server
+   round trip for color names but handles "rgb:" specs on its own.
+*/
+string resolveColor(const string &spec) {
+    XColor color;
+    if (!parseColor(spec, color))
+        return spec;
+
+    char buf[32];
+    snprintf(buf, sizeof(buf), "rgb:%04x/%04x/%04x",
+             color.red, color.green, color.blue);
+    return buf;
+}
+
+/// Xrm handles #include itself, we can't tell when included files change
+bool hasIncludes(const string &filename) {
+    if (filename.empty())
+        return false;
+    std::ifstream infile(filename.c_str());
+    string line;
+    while (getline(infile, line)) {
+        if (line.compare(0, 8, "#include") == 0)
+            return true;
+    }
+    return false;
+}
+
+} // end anonymous namespace
+
 namespace FbTk {
 
 struct LoadThemeHelper {
@@ -81,7 +182,9 @@ ThemeManager::ThemeManager():
     // without having a display connection
     m_max_screens(-1),
     m_verbose(false),
-    m_themelocation("") {
+    m_themelocation(""),
+    m_database_loaded(false),
+    m_values_changed(false) {
 
 }
 
@@ -138,23 +241,35 @@ bool ThemeManager::load(const string &filename,
         prefix = location.substr(0, location.find_last_of('/'));
     }
 
-    if (!m_database.load(location.c_str()))
-        return false;
-
-
+    string overlay_location;
     if (!overlay_filename.empty()) {
-        string overlay_location = FbTk::StringUtil::expandFilename(overlay_filename);
-        if (FileUtil::isRegularFile(overlay_location.c_str())) {
-            XrmDatabaseHelper overlay_db;
-            if (overlay_db.load(overlay_location.c_str())) {
-                // after a merge the src_db is destroyed
-                // so, make sure XrmDatabaseHelper::m_database == 0
-                XrmMergeDatabases(*overlay_db, &(*m_database));
-                *overlay_db = 0;
-            }
-        }
+        overlay_location = FbTk::StringUtil::expandFilename(overlay_filename);
+        if (!FileUtil::isRegularFile(overlay_location.c_str()))
+            overlay_location.clear();
     }
 
+    const string old_style = m_style_file;
+    const string old_overlay = m_overlay_file;
+    m_style_file = location;
+    m_overlay_file = overlay_location;
+
+    bool from_cache = readCache();
+    if (from_cache) {
+        // parsed on demand, if a theme asks for something new
+        m_database.close();
+        m_database_loaded = false;
+    } else if (loadDatabase()) {
+        m_values.clear();
+        m_values_changed = false;
+    } else {
+        m_style_file = old_style;
+        m_overlay_file = old_overlay;
+        return false;
+    }
+
+    if (from_cache && verbose())
+        checkCache();
+
     // relies on the fact that load_rc clears search paths each time
     if (m_themelocation != "") {
         Image::removeSearchPath(m_themelocation);
@@ -179,9 +294,195 @@ bool ThemeManager::load(const string &filename,
         load_theme_helper(m_themes[screen_num]);
     }
 
+    saveCache();
+
     return true;
 }
 
+bool ThemeManager::loadDatabase() {
+    if (!m_database.load(m_style_file.c_str()))
+        return false;
+
+    if (!m_overlay_file.empty()) {
+        XrmDatabaseHelper overlay_db;
+        if (overlay_db.load(m_overlay_file.c_str())) {
+            // after a merge the src_db is destroyed
+            // so, make sure XrmDatabaseHelper::m_database == 0
+            XrmMergeDatabases(*overlay_db, &(*m_database));
+            *overlay_db = 0;
+        }
+    }
+
+    m_database_loaded = true;
+    return true;
+}
+
+const string *ThemeManager::lookup(const string &name, const string &altname) {
+    string key(name);
+    key += '\0';
+    key += altname;
+
+    ValueMap::iterator it = m_values.find(key);
+    if (it == m_values.end()) {
+        // a compiled style doesn't know about this one, ask the real thing
+        if (!m_database_loaded && !m_style_file.empty())
+            loadDatabase();
+
+        CachedValue cached;
+        cached.found = false;
+        XrmValue value;
+        char *value_type;
+        if (*m_database != 0 && XrmGetResource(*m_database, name.c_str(),
+                                               altname.c_str(), &value_type, &value) &&
+            value.addr != 0) {
+            cached.found = true;
+            cached.value = value.addr;
+        }
+        it = m_values.insert(ValueMap::value_type(key, cached)).first;
+        m_values_changed = true;
+    }
+
+    return it->second.found ? &it->second.value : 0;
+}
+
+string ThemeManager::cacheFilename() const {
+    // FNV-1a over the files that make up the style
+    const string id = m_style_file + '\n' + m_overlay_file;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < id.size(); ++i) {
+        hash ^= static_cast<unsigned char>(id[i]);
+        hash *= 16777619u;
+    }
+    char name[32];
+    snprintf(name, sizeof(name), "/style-%08x", hash);
+    return m_cache_dir + name;
+}
+
+bool ThemeManager::readCache() {
+    if (m_cache_dir.empty() || m_style_file.empty())
+        return false;
+
+    std::ifstream infile(cacheFilename().c_str(), std::ios::binary);
+    if (!infile)
+        return false;
+
+    char magic[sizeof(CACHE_MAGIC)];
+    if (!infile.read(magic, sizeof(magic)) ||
+        memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0)
+        return false;
+
+    string style, overlay;
+    FileStamp style_stamp, overlay_stamp;
+    if (!readString(infile, style) || style != m_style_file ||
+        !readString(infile, overlay) || overlay != m_overlay_file ||
+        !readInt(infile, style_stamp.mtime) || !readInt(infile, style_stamp.size) ||
+        !readInt(infile, overlay_stamp.mtime) || !readInt(infile, overlay_stamp.size))
+        return false;
+
+    if (!(style_stamp == FileStamp(m_style_file)) ||
+        !(overlay_stamp == FileStamp(m_overlay_file)))
+        return false;
+
+    int64_t count;
+    if (!readInt(infile, count) || count < 0)
+        return false;
+
+    ValueMap values;
+    string key;
+    CachedValue cached;
+    for (int64_t i = 0; i < count; ++i) {
+        char found;
+        if (!infile.get(found) || !readString(infile, key) ||
+            !readString(infile, cached.value))
+            return false;
+        cached.found = found != 0;
+        values.insert(values.end(), ValueMap::value_type(key, cached));
+    }
+
+    m_values.swap(values);
+    m_values_changed = false;
+    return true;
+}
+
+void ThemeManager::saveCache() {
+    if (m_cache_dir.empty() || m_style_file.empty() || !m_values_changed)
+        return;
+    m_values_changed = false;
+
+    if (hasIncludes(m_style_file) || hasIncludes(m_overlay_file))
+        return;
+
+    if (!FileUtil::isDirectory(m_cache_dir.c_str()))
+        mkdir(m_cache_dir.c_str(), 0700);
+
+    const string filename = cacheFilename();
+    const string tmp_filename = filename + ".tmp";
+    std::ofstream outfile(tmp_filename.c_str(), std::ios::binary | std::ios::trunc);
+    if (!outfile)
+        return;
+
+    const FileStamp style_stamp(m_style_file), overlay_stamp(m_overlay_file);
+    outfile.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    writeString(outfile, m_style_file);
+    writeString(outfile, m_overlay_file);
+    writeInt(outfile, style_stamp.mtime);
+    writeInt(outfile, style_stamp.size);
+    writeInt(outfile, overlay_stamp.mtime);
+    writeInt(outfile, overlay_stamp.size);
+    writeInt(outfile, m_values.size());
+
+    ValueMap::const_iterator it = m_values.begin();
+    ValueMap::const_iterator it_end = m_values.end();
+    for (; it != it_end; ++it) {
+        outfile.put(it->second.found ? 1 : 0);
+        writeString(outfile, it->first);
+        if (it->second.found && isColorResource(it->first.substr(0, it->first.find('\0'))))
+            writeString(outfile, resolveColor(it->second.value));
+        else
+            writeString(outfile, it->second.value);
+    }
+    outfile.close();
+
+    if (!outfile || rename(tmp_filename.c_str(), filename.c_str()) != 0)
+        unlink(tmp_filename.c_str());
+}
+
+int ThemeManager::checkCache() {
+    if (!m_database_loaded && !loadDatabase())
+        return -1;
+
+    int mismatches = 0;
+    ValueMap::const_iterator it = m_values.begin();
+    ValueMap::const_iterator it_end = m_values.end();
+    for (; it != it_end; ++it) {
+        const size_t split = it->first.find('\0');
+        const string name = it->first.substr(0, split);
+        const string altname = it->first.substr(split + 1);
+
+        XrmValue value;
+        char *value_type;
+        bool found = XrmGetResource(*m_database, name.c_str(), altname.c_str(),
+                                    &value_type, &value) && value.addr != 0;
+        bool same = found == it->second.found;
+        if (same && found && it->second.value != value.addr) {
+            XColor cached_color, color;
+            same = isColorResource(name) &&
+                parseColor(it->second.value, cached_color) &&
+                parseColor(value.addr, color) &&
+                cached_color.red == color.red &&
+                cached_color.green == color.green &&
+                cached_color.blue == color.blue;
+        }
+        if (!same) {
+            cerr<<"ThemeManager: compiled style differs for "<<name<<": \""
+                <<(it->second.found ? it->second.value : "<unset>")<<"\" != \""
+                <<(found ? value.addr : "<unset>")<<"\""<<endl;
+            ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
 void ThemeManager::loadTheme(Theme &tm) {
     Theme::ItemList::iterator i = tm.itemList().begin();
     Theme::ItemList::iterator i_end = tm.itemList().end();
@@ -207,26 +508,19 @@ bool ThemeManager::loadItem(ThemeItem_base &resource) {
 
 /// handles resource item loading with specific name/altname
 bool ThemeManager::loadItem(ThemeItem_base &resource, const string &name, const string &alt_name) {
-    XrmValue value;
-    char *value_type;
-    if (XrmGetResource(*m_database, name.c_str(),
-                       alt_name.c_str(), &value_type, &value)) {
-        resource.setFromString(value.addr);
-        resource.load(&name, &alt_name); // load additional stuff by the ThemeItem
-    } else
+    const string *value = lookup(name, alt_name);
+    if (value == 0)
         return false;
 
+    resource.setFromString(value->c_str());
+    resource.load(&name, &alt_name); // load additional stuff by the ThemeItem
+
     return true;
 }
 
 string ThemeManager::resourceValue(const string &name, const string &altname) {
-    XrmValue value;
-    char *value_type;
-    if (*m_database != 0 && XrmGetResource(*m_database, name.c_str(),
-                                           altname.c_str(), &value_type, &value) && value.addr != 0)
-        return string(value.addr);
-
-    return "";
+    const string *value = lookup(name, altname);
+    return value ? *value : "";
 }
 
 /*
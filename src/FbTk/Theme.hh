@@ -31,6 +31,7 @@
 
 #include <string>
 #include <list>
+#include <map>
 #include <vector>
 
 namespace FbTk {
@@ -150,6 +151,21 @@ public:
     bool verbose() const { return m_verbose; }
     void setVerbose(bool value) { m_verbose = value; }
 
+    /**
+       Directory for compiled styles, an empty name disables the cache.
+       A compiled style holds every resource value the themes asked for,
+       keyed on the style and overlay files, so loading it again
+       does not need to parse the style into an Xrm database at all.
+    */
+    void setCacheDirectory(const std::string &dirname) { m_cache_dir = dirname; }
+    /// write the compiled style if themes asked for new resources since
+    void saveCache();
+    /**
+       compare the compiled style against a freshly parsed style file
+       @return number of resources that differ
+    */
+    int checkCache();
+
     // dump theme out to filename, stdout if no filename is given
     void dump(Theme& theme, const char* filename = 0) const;
     //    void listItems();
@@ -163,6 +179,21 @@ private:
     bool registerTheme(FbTk::Theme &tm);
     /// @return false if theme isn't registred in the manager
     bool unregisterTheme(FbTk::Theme &tm);
+
+    /// resolved value of a resource, NULL if the style doesn't define it
+    const std::string *lookup(const std::string &name, const std::string &altname);
+    /// load the style (and overlay) into m_database
+    bool loadDatabase();
+    bool readCache();
+    std::string cacheFilename() const;
+
+    /// cached answer to a name/altname lookup
+    struct CachedValue {
+        bool found;
+        std::string value;
+    };
+    typedef std::map<std::string, CachedValue> ValueMap; ///< "name\0altname" -> value
+
     /// map each theme manager to a screen
 
     ScreenThemeVector m_themes;
@@ -171,6 +202,13 @@ private:
     bool m_verbose;
 
     std::string m_themelocation;
+
+    std::string m_style_file;   ///< style file of the current style
+    std::string m_overlay_file; ///< overlay file of the current style
+    bool m_database_loaded;     ///< m_database holds the current style
+    ValueMap m_values;          ///< every resource asked for so far
+    bool m_values_changed;      ///< m_values has entries the cache file lacks
+    std::string m_cache_dir;
 };
 
 
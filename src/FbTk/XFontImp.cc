@@ -21,17 +21,28 @@
 
 #include "XFontImp.hh"
 #include "App.hh"
+#include "FbDrawable.hh"
 #include "GContext.hh"
 #include "FbPixmap.hh"
+#include "Transparent.hh"
 #include "I18n.hh"
 
 #include <X11/Xutil.h>
+#ifdef HAVE_XRENDER
+#include <X11/extensions/Xrender.h>
+#endif // HAVE_XRENDER
 
 #include <iostream>
 #include <new>
 #include <cstdio>
 #include <cstring>
 #include <algorithm>
+#include <vector>
+
+// for the clip state of a GC; last, as it defines min() and max()
+#include <X11/Xlibint.h>
+#undef min
+#undef max
 
 
 using std::cerr;
@@ -41,7 +52,8 @@ using std::nothrow;
 
 namespace FbTk {
 
-XFontImp::XFontImp(const char *fontname):m_fontstruct(0) {
+XFontImp::XFontImp(const char *fontname):m_fontstruct(0),
+    m_fill(0), m_fill_pic(0), m_fill_gc(0), m_fill_screen(-1), m_fill_pixel(0) {
     for (int i = ROT0; i <= ROT270; ++i) {
         m_rotfonts[i] = 0;
         m_rotfonts_loaded[i] = false;
@@ -58,6 +70,16 @@ XFontImp::~XFontImp() {
     for (int i = ROT0; i <= ROT270; ++i)
         if (m_rotfonts[i] != 0)
             freeRotFont(m_rotfonts[i]);
+
+    Display *dpy = App::instance()->display();
+#ifdef HAVE_XRENDER
+    if (m_fill_pic != 0)
+        XRenderFreePicture(dpy, m_fill_pic);
+#endif // HAVE_XRENDER
+    if (m_fill_gc != 0)
+        XFreeGC(dpy, m_fill_gc);
+    if (m_fill != 0)
+        XFreePixmap(dpy, m_fill);
 }
 
 int XFontImp::ascent() const {
@@ -97,7 +119,7 @@ void XFontImp::drawText(const FbDrawable &w, int screen, GC gc, const char* text
 
     // use roated font functions?
     if (orient != ROT0 && validOrientation(orient)) {
-        drawRotText(w.drawable(), screen, gc, localestr.c_str(), localestr.size(), x, y, orient);
+        drawRotText(w, screen, gc, localestr.c_str(), localestr.size(), x, y, orient);
         return;
     }
 
@@ -158,6 +180,9 @@ void XFontImp::rotate(FbTk::Orientation orient) {
         return;
     }
 
+    rotfont->atlas = None;
+    rotfont->glyphset = 0;
+
     // determine which characters are defined in font
     min_char = m_fontstruct->min_char_or_byte2;
     max_char = m_fontstruct->max_char_or_byte2;
@@ -175,23 +200,65 @@ void XFontImp::rotate(FbTk::Orientation orient) {
     rotfont->max_descent = m_fontstruct->max_bounds.descent;
     rotfont->height = rotfont->max_ascent + rotfont->max_descent;
 
-    // font needs rotation
-    // loop through each character
+    // first the metrics, they tell us where each glyph goes in the atlas
+    int atlas_w = 0, atlas_h = 1;
     for (ichar = min_char; ichar <= max_char; ichar++) {
         index = ichar - m_fontstruct->min_char_or_byte2;
+        XRotCharStruct &rotchar = rotfont->per_char[ichar-32];
 
         // per char dimensions ...
-        ascent = rotfont->per_char[ichar-32].ascent = m_fontstruct->per_char[index].ascent;
-        descent =  rotfont->per_char[ichar-32].descent = m_fontstruct->per_char[index].descent;
-        lbearing = rotfont->per_char[ichar-32].lbearing = m_fontstruct->per_char[index].lbearing;
-        rbearing = rotfont->per_char[ichar-32].rbearing = m_fontstruct->per_char[index].rbearing;
-        rotfont->per_char[ichar-32].width = m_fontstruct->per_char[index].width;
+        rotchar.ascent = m_fontstruct->per_char[index].ascent;
+        rotchar.descent = m_fontstruct->per_char[index].descent;
+        rotchar.lbearing = m_fontstruct->per_char[index].lbearing;
+        rotchar.rbearing = m_fontstruct->per_char[index].rbearing;
+        rotchar.width = m_fontstruct->per_char[index].width;
 
         // some space chars have zero body, but a bitmap can't have
-        if (!ascent && !descent)
-            ascent = rotfont->per_char[ichar-32].ascent =   1;
-        if (!lbearing && !rbearing)
-            rbearing = rotfont->per_char[ichar-32].rbearing = 1;
+        if (!rotchar.ascent && !rotchar.descent)
+            rotchar.ascent = 1;
+        if (!rotchar.lbearing && !rotchar.rbearing)
+            rotchar.rbearing = 1;
+
+        // glyph width and height when vertical
+        vert_w = rotchar.rbearing - rotchar.lbearing;
+        vert_h = rotchar.ascent + rotchar.descent;
+
+        // width, height of rotated character
+        if (orient == ROT180) {
+            rotchar.glyph.bit_w = vert_w;
+            rotchar.glyph.bit_h = vert_h;
+        } else {
+            rotchar.glyph.bit_w = vert_h;
+            rotchar.glyph.bit_h = vert_w;
+        }
+        rotchar.glyph.atlas_x = atlas_w;
+        atlas_w += rotchar.glyph.bit_w;
+        atlas_h = std::max(atlas_h, rotchar.glyph.bit_h);
+    }
+
+    // all glyphs go into one bitmap, so a label needs one stipple
+    rotfont->atlas = XCreatePixmap(dpy, rootwin, std::max(atlas_w, 1), atlas_h, 1);
+    font_gc.setForeground(None);
+    XFillRectangle(dpy, rotfont->atlas, font_gc.gc(), 0, 0, std::max(atlas_w, 1), atlas_h);
+
+#ifdef HAVE_XRENDER
+    // with XRender, a label is a single request
+    XRenderPictFormat *glyph_format = 0;
+    if (Transparent::haveRender())
+        glyph_format = XRenderFindStandardFormat(dpy, PictStandardA8);
+    if (glyph_format)
+        rotfont->glyphset = XRenderCreateGlyphSet(dpy, glyph_format);
+    std::vector<char> glyph_data;
+#endif // HAVE_XRENDER
+
+    // font needs rotation
+    // loop through each character
+    for (ichar = min_char; ichar <= max_char; ichar++) {
+        XRotCharStruct &rotchar = rotfont->per_char[ichar-32];
+        ascent = rotchar.ascent;
+        descent = rotchar.descent;
+        lbearing = rotchar.lbearing;
+        rbearing = rotchar.rbearing;
 
         // glyph width and height when vertical
         vert_w = rbearing - lbearing;
@@ -205,7 +272,7 @@ void XFontImp::rotate(FbTk::Orientation orient) {
                              0, 0,
                              boxlen, boxlen);
         // draw the character centre top right on canvas
-        snprintf(text, 1, "%c", ichar);
+        snprintf(text, sizeof(text), "%c", ichar);
         font_gc.setForeground(1);
         XDrawImageString(dpy, canvas.drawable(), font_gc.gc(),
                          boxlen/2 - lbearing,
@@ -225,7 +292,7 @@ void XFontImp::rotate(FbTk::Orientation orient) {
                                          "XCreateImage failed for some reason")
                  << "." << endl;
             free(vertdata);
-            delete rotfont;
+            freeRotFont(rotfont);
             m_rotfonts[orient] = 0;
             return;
         }
@@ -239,21 +306,12 @@ void XFontImp::rotate(FbTk::Orientation orient) {
 
         I1->format = XYBitmap;
 
-        // width, height of rotated character
-        if (orient == ROT180) {
-            bit_w = vert_w;
-            bit_h = vert_h;
-        } else {
-            bit_w = vert_h;
-            bit_h = vert_w;
-        }
+        bit_w = rotchar.glyph.bit_w;
+        bit_h = rotchar.glyph.bit_h;
 
         // width in bytes
         bit_len = (bit_w-1)/8 + 1;
 
-        rotfont->per_char[ichar-32].glyph.bit_w = bit_w;
-        rotfont->per_char[ichar-32].glyph.bit_h = bit_h;
-
         // reserve memory for the rotated image
         bitdata = (unsigned char *)calloc((unsigned)(bit_h * bit_len), 1);
 
@@ -268,7 +326,7 @@ void XFontImp::rotate(FbTk::Orientation orient) {
                  << "." << endl;
             XDestroyImage(I1);
             free(bitdata);
-            delete rotfont;
+            freeRotFont(rotfont);
             m_rotfonts[orient] = 0;
             return;
         }
@@ -296,13 +354,45 @@ void XFontImp::rotate(FbTk::Orientation orient) {
             }
         }
 
-        // create this character's bitmap
-        rotfont->per_char[ichar-32].glyph.bm =
-            XCreatePixmap(dpy, rootwin, bit_w, bit_h, 1);
+        // put the image into the atlas
+        XPutImage(dpy, rotfont->atlas,
+                  font_gc.gc(), I2, 0, 0, rotchar.glyph.atlas_x, 0, bit_w, bit_h);
+
+#ifdef HAVE_XRENDER
+        if (rotfont->glyphset) {
+            // 8 bit alpha, scanlines padded to 32 bit
+            const int stride = (bit_w + 3) & ~3;
+            glyph_data.assign(stride * bit_h, 0);
+            for (j = 0; j < bit_h; j++) {
+                for (i = 0; i < bit_w; i++) {
+                    if (bitdata[j*bit_len + i/8] & (128>>(i%8)))
+                        glyph_data[j*stride + i] = static_cast<char>(0xff);
+                }
+            }
 
-        // put the image into the bitmap
-        XPutImage(dpy, rotfont->per_char[ichar-32].glyph.bm,
-                  font_gc.gc(), I2, 0, 0, 0, 0, bit_w, bit_h);
+            // the origin is where drawRotText positions the glyph
+            XGlyphInfo info;
+            info.width = bit_w;
+            info.height = bit_h;
+            info.xOff = info.yOff = 0;
+            if (orient == ROT270) {
+                info.x = ascent;
+                info.y = rbearing;
+                info.yOff = -rotchar.width;
+            } else if (orient == ROT180) {
+                info.x = rbearing;
+                info.y = descent - 1;
+                info.xOff = -rotchar.width;
+            } else { // ROT90
+                info.x = descent;
+                info.y = -lbearing;
+                info.yOff = rotchar.width;
+            }
+            Glyph gid = ichar;
+            XRenderAddGlyphs(dpy, rotfont->glyphset, &gid, &info, 1,
+                             &glyph_data[0], glyph_data.size());
+        }
+#endif // HAVE_XRENDER
 
         // free the image and data
         XDestroyImage(I1);
@@ -312,71 +402,137 @@ void XFontImp::rotate(FbTk::Orientation orient) {
 }
 
 void XFontImp::freeRotFont(XRotFontStruct *rotfont) {
-    // loop through each character and free its pixmap
-    for (int ichar = rotfont->min_char - 32;
-         ichar <= rotfont->max_char - 32; ++ichar) {
-        XFreePixmap(App::instance()->display(), rotfont->per_char[ichar].glyph.bm);
-    }
+    Display *dpy = App::instance()->display();
+    if (rotfont->atlas != None)
+        XFreePixmap(dpy, rotfont->atlas);
+#ifdef HAVE_XRENDER
+    if (rotfont->glyphset != 0)
+        XRenderFreeGlyphSet(dpy, rotfont->glyphset);
+#endif // HAVE_XRENDER
 
     delete rotfont;
-    rotfont = 0;
 }
 
-void XFontImp::drawRotText(Drawable w, int screen, GC gc, const char* text, size_t len, int x, int y, FbTk::Orientation orient) const {
+void XFontImp::drawRotText(const FbDrawable &w, int screen, GC gc, const char* text, size_t len, int x, int y, FbTk::Orientation orient) {
 
     if (!text || !*text || len<1)
         return;
 
+    XRotFontStruct *rotfont = m_rotfonts[orient];
+
+    // only the printing characters we have glyphs for
+    std::string glyphs;
+    glyphs.reserve(len);
+    for (size_t i = 0; i < len; i++) {
+        int c = static_cast<unsigned char>(text[i]);
+        if (c >= rotfont->min_char && c <= rotfont->max_char)
+            glyphs += text[i];
+    }
+    if (glyphs.empty())
+        return;
+
+    if (rotfont->glyphset && drawGlyphs(w, screen, gc, glyphs.data(), glyphs.size(), x, y, orient))
+        return;
+
     Display *dpy = App::instance()->display();
     static GC my_gc = 0;
     int xp, yp, ichar;
 
-    XRotFontStruct *rotfont = m_rotfonts[orient];
-
     if (my_gc == 0)
-        my_gc = XCreateGC(dpy, w, 0, 0);
+        my_gc = XCreateGC(dpy, w.drawable(), 0, 0);
 
     XCopyGC(dpy, gc, GCForeground|GCBackground, my_gc);
 
     // vertical or upside down
     XSetFillStyle(dpy, my_gc, FillStippled);
+    XSetStipple(dpy, my_gc, rotfont->atlas);
 
     // loop through each character in texting
-    for (size_t i = 0; i<len; i++) {
-        ichar = text[i]-32;
+    for (size_t i = 0; i < glyphs.size(); i++) {
+        ichar = static_cast<unsigned char>(glyphs[i]) - 32;
+        const XRotCharStruct &rotchar = rotfont->per_char[ichar];
+
+        // suitable offset
+        if (orient == ROT270) {
+            xp = x-rotchar.ascent;
+            yp = y-rotchar.rbearing;
+        } else if (orient == ROT180) {
+            xp = x-rotchar.rbearing;
+            yp = y-rotchar.descent+1;
+        } else { // ROT90
+            xp = x-rotchar.descent;
+            yp = y+rotchar.lbearing;
+        }
 
-        // make sure it's a printing character
-        if (ichar >= 0 && ichar<95) {
-            // suitable offset
-            if (orient == ROT270) {
-                xp = x-rotfont->per_char[ichar].ascent;
-                yp = y-rotfont->per_char[ichar].rbearing;
-            } else if (orient == ROT180) {
-                xp = x-rotfont->per_char[ichar].rbearing;
-                yp = y-rotfont->per_char[ichar].descent+1;
-            } else { // ROT90
-                xp = x-rotfont->per_char[ichar].descent;
-                yp = y+rotfont->per_char[ichar].lbearing;
-            }
+        // draw the glyph, moving the atlas so it lines up
+        XSetTSOrigin(dpy, my_gc, xp - rotchar.glyph.atlas_x, yp);
 
-            // draw the glyph
-            XSetStipple(dpy, my_gc, rotfont->per_char[ichar].glyph.bm);
+        XFillRectangle(dpy, w.drawable(), my_gc, xp, yp,
+                       rotchar.glyph.bit_w,
+                       rotchar.glyph.bit_h);
+
+        // advance position
+        if (orient == ROT270)
+            y -= rotchar.width;
+        else if (orient == ROT180)
+            x -= rotchar.width;
+        else
+            y += rotchar.width;
+    }
+}
 
-            XSetTSOrigin(dpy, my_gc, xp, yp);
+bool XFontImp::drawGlyphs(const FbDrawable &w, int screen, GC gc, const char* text, size_t len, int x, int y, FbTk::Orientation orient) {
+#ifdef HAVE_XRENDER
+    Display *dpy = App::instance()->display();
 
-            XFillRectangle(dpy, w, my_gc, xp, yp,
-                           rotfont->per_char[ichar].glyph.bit_w,
-                           rotfont->per_char[ichar].glyph.bit_h);
+    // the fill below is in the default visual, so is the destination;
+    // ARGB frames and other depths take the core path
+    XRenderPictFormat *format = XRenderFindVisualFormat(dpy, DefaultVisual(dpy, screen));
+    XRenderPictFormat *glyph_format = XRenderFindStandardFormat(dpy, PictStandardA8);
+    if (format == 0 || glyph_format == 0 ||
+        static_cast<unsigned int>(format->depth) != w.depth())
+        return false;
 
-            // advance position
-            if (orient == ROT270)
-                y -= rotfont->per_char[ichar].width;
-            else if (orient == ROT180)
-                x -= rotfont->per_char[ichar].width;
-            else
-                y += rotfont->per_char[ichar].width;
+    // GC values are cached by Xlib, this doesn't hit the server
+    XGCValues values;
+    if (!XGetGCValues(dpy, gc, GCForeground|GCFunction|GCPlaneMask, &values))
+        return false;
+    if (values.function != GXcopy || ~values.plane_mask != 0)
+        return false;
+    // Xlib can't tell us the clip, but it knows whether there is one
+    if (gc->rects || gc->values.clip_mask != None)
+        return false;
+
+    bool refill = false;
+    if (m_fill_pic == 0 || m_fill_screen != screen) {
+        if (m_fill_pic != 0) {
+            XRenderFreePicture(dpy, m_fill_pic);
+            XFreeGC(dpy, m_fill_gc);
+            XFreePixmap(dpy, m_fill);
         }
+        m_fill = XCreatePixmap(dpy, RootWindow(dpy, screen), 1, 1, DefaultDepth(dpy, screen));
+        XRenderPictureAttributes attr;
+        attr.repeat = True;
+        m_fill_pic = XRenderCreatePicture(dpy, m_fill, format, CPRepeat, &attr);
+        m_fill_gc = XCreateGC(dpy, m_fill, 0, 0);
+        m_fill_screen = screen;
+        refill = true;
     }
+
+    if (refill || values.foreground != m_fill_pixel) {
+        XSetForeground(dpy, m_fill_gc, values.foreground);
+        XFillRectangle(dpy, m_fill, m_fill_gc, 0, 0, 1, 1);
+        m_fill_pixel = values.foreground;
+    }
+
+    Picture dest = XRenderCreatePicture(dpy, w.drawable(), format, 0, 0);
+    XRenderCompositeString8(dpy, PictOpOver, m_fill_pic, dest, glyph_format,
+                            m_rotfonts[orient]->glyphset, 0, 0, x, y, text, len);
+    XRenderFreePicture(dpy, dest);
+    return true;
+#else
+    return false;
+#endif // HAVE_XRENDER
 }
 
 
@@ -47,7 +47,7 @@ private:
         int bit_w;
         int bit_h;
 
-        Pixmap bm;
+        int atlas_x; ///< position of the glyph in the atlas
     };
     struct XRotCharStruct {
         int ascent;
@@ -67,17 +67,33 @@ private:
         int min_char;
 
         XRotCharStruct per_char[95];
+
+        Pixmap atlas; ///< all glyphs side by side, used as stipple
+        XID glyphset; ///< the glyphs as XRender glyphset, if available
     };
 
     void rotate(FbTk::Orientation orient);
 
     void freeRotFont(XRotFontStruct * rotfont);
-    void drawRotText(Drawable w, int screen, GC gc, const char* text, size_t len, int x, int y, FbTk::Orientation orient) const;
+    void drawRotText(const FbDrawable &w, int screen, GC gc, const char* text, size_t len, int x, int y, FbTk::Orientation orient);
+    /**
+     * Draw the label with one XRender request. False if we can't, i.e. w
+     * isn't of the screen's default depth or gc isn't a plain copy with
+     * no clipping; the core path handles those.
+     */
+    bool drawGlyphs(const FbDrawable &w, int screen, GC gc, const char* text, size_t len, int x, int y, FbTk::Orientation orient);
 
     XRotFontStruct *m_rotfonts[4]; ///< rotated font structure (only 3 used)
     bool m_rotfonts_loaded[4]; // whether we've tried yet
     XFontStruct *m_fontstruct; ///< X font structure
 
+    // solid source for drawGlyphs, refilled when the text color changes
+    Pixmap m_fill;
+    XID m_fill_pic;
+    GC m_fill_gc;
+    int m_fill_screen;
+    unsigned long m_fill_pixel;
+
 };
 
 } // end namespace FbTk
@@ -0,0 +1,190 @@
+// XIDTable.hh for FbTk - Fluxbox Toolkit
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#ifndef FBTK_XIDTABLE_HH
+#define FBTK_XIDTABLE_HH
+
+#include <X11/X.h>
+
+#include <vector>
+#include <cstddef>
+
+namespace FbTk {
+
+/**
+   Hash table from XID to T, for the lookups done on every X event.
+
+   Open addressing with linear probing, so a lookup is usually a single
+   cache line. Erasing shifts the following entries back instead of
+   leaving tombstones, so the table doesn't degrade over time as windows
+   come and go. T must be default constructible and assignable.
+ */
+template <typename T>
+class XIDTable {
+public:
+    XIDTable(): m_size(0), m_mask(0), m_shift(0), m_has_none(false) { }
+
+    /// @return value for xid, 0 if there is none
+    T *find(XID xid) {
+        if (xid == None)
+            return m_has_none ? &m_none.value : 0;
+        if (m_slots.empty())
+            return 0;
+        for (size_t i = home(xid); ; i = (i + 1) & m_mask) {
+            if (m_slots[i].key == xid)
+                return &m_slots[i].value;
+            if (m_slots[i].key == None)
+                return 0;
+        }
+    }
+
+    const T *find(XID xid) const {
+        return const_cast<XIDTable *>(this)->find(xid);
+    }
+
+    /// @return value for xid, default constructed if it wasn't there
+    T &operator[](XID xid) {
+        if (xid == None) {
+            if (!m_has_none) {
+                m_has_none = true;
+                m_none.value = T();
+                ++m_size;
+            }
+            return m_none.value;
+        }
+
+        // keep the load factor at or below 1/2
+        if ((m_size + 1) * 2 > m_slots.size())
+            grow();
+
+        size_t i = home(xid);
+        for (; m_slots[i].key != None; i = (i + 1) & m_mask) {
+            if (m_slots[i].key == xid)
+                return m_slots[i].value;
+        }
+        m_slots[i].key = xid;
+        m_slots[i].value = T();
+        ++m_size;
+        return m_slots[i].value;
+    }
+
+    void erase(XID xid) {
+        if (xid == None) {
+            if (m_has_none) {
+                m_has_none = false;
+                m_none.value = T();
+                --m_size;
+            }
+            return;
+        }
+        if (m_slots.empty())
+            return;
+
+        size_t i = home(xid);
+        for (; m_slots[i].key != xid; i = (i + 1) & m_mask) {
+            if (m_slots[i].key == None)
+                return;
+        }
+        --m_size;
+
+        // move later entries of the probe sequence into the hole, as long
+        // as that doesn't put them before their home slot
+        for (size_t j = (i + 1) & m_mask; m_slots[j].key != None; j = (j + 1) & m_mask) {
+            size_t k = home(m_slots[j].key);
+            if (((j - k) & m_mask) >= ((j - i) & m_mask)) {
+                m_slots[i] = m_slots[j];
+                i = j;
+            }
+        }
+        m_slots[i].key = None;
+        m_slots[i].value = T();
+    }
+
+    void clear() {
+        m_slots.clear();
+        m_size = 0;
+        m_mask = m_shift = 0;
+        m_has_none = false;
+        m_none.value = T();
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    /// calls f(xid, value) for all entries, in no particular order
+    template <typename F>
+    void forAll(F f) const {
+        if (m_has_none)
+            f(XID(None), m_none.value);
+        for (size_t i = 0; i < m_slots.size(); ++i) {
+            if (m_slots[i].key != None)
+                f(m_slots[i].key, m_slots[i].value);
+        }
+    }
+
+private:
+    struct Slot {
+        Slot(): key(None), value() { }
+        XID key;
+        T value;
+    };
+
+    /// XIDs of one client are mostly sequential, Fibonacci hashing spreads them
+    size_t home(XID xid) const {
+        return static_cast<size_t>((static_cast<unsigned long long>(xid) *
+                                    0x9E3779B97F4A7C15ULL) >> m_shift) & m_mask;
+    }
+
+    void grow() {
+        std::vector<Slot> old;
+        old.swap(m_slots);
+
+        size_t capacity = old.empty() ? 64 : old.size() * 2;
+        m_slots.resize(capacity);
+        m_mask = capacity - 1;
+        m_shift = 64;
+        for (size_t c = capacity; c > 1; c >>= 1)
+            --m_shift;
+
+        for (size_t i = 0; i < old.size(); ++i) {
+            if (old[i].key == None)
+                continue;
+            size_t j = home(old[i].key);
+            while (m_slots[j].key != None)
+                j = (j + 1) & m_mask;
+            m_slots[j] = old[i];
+        }
+    }
+
+    std::vector<Slot> m_slots; ///< size is zero or a power of two
+    size_t m_size; ///< number of entries, including the None entry
+    size_t m_mask;
+    unsigned int m_shift;
+
+    // None marks empty slots, so it is stored on the side
+    Slot m_none;
+    bool m_has_none;
+};
+
+} // end namespace FbTk
+
+#endif // FBTK_XIDTABLE_HH
@@ -87,7 +87,7 @@ void render(FbTk::Color &col, Pixmap &pm, unsigned int width, unsigned int heigh
         pm = None;
         col = tex.color();
     } else {
-        pm = ictl.renderImage(width, height, tex, orient);
+        pm = ictl.renderBackground(width, height, tex, orient);
     }
 
     if (tmp)
@@ -142,6 +142,7 @@ FbWinFrame::FbWinFrame(BScreen &screen, unsigned int client_depth,
     m_use_tabs(true),
     m_use_handle(true),
     m_visible(false),
+    m_dirty(0),
     m_tabmode(screen.getDefaultInternalTabs()?INTERNAL:EXTERNAL),
     m_active_orig_client_bw(0),
     m_need_render(true),
@@ -431,6 +432,7 @@ void FbWinFrame::notifyMoved(bool clear) {
 }
 
 void FbWinFrame::clearAll() {
+    m_dirty = 0;
 
     if  (m_use_titlebar) {
         redrawTitlebar();
@@ -467,7 +469,7 @@ void FbWinFrame::setFocus(bool newvalue) {
     setBorderWidth();
 
     applyAll();
-    clearAll();
+    redrawDirty();
 }
 
 void FbWinFrame::applyState() {
@@ -522,7 +524,7 @@ void FbWinFrame::applyAlpha() {
     else {
         // don't need to setAlpha, since apply updates them anyway
         applyAll();
-        clearAll();
+        redrawDirty();
     }
 }
 
@@ -1062,12 +1064,16 @@ void FbWinFrame::renderAll() {
 }
 
 void FbWinFrame::applyAll() {
+    m_dirty = 0;
     applyTitlebar();
     applyHandles();
     applyTabContainer();
 }
 
 void FbWinFrame::renderTitlebar() {
+    // the image control may hand out the old pixmap ids with new content
+    m_title_applied.valid = m_label_applied.valid = false;
+
     if (!m_use_titlebar)
         return;
 
@@ -1097,6 +1103,8 @@ void FbWinFrame::renderTitlebar() {
 }
 
 void FbWinFrame::renderTabContainer() {
+    m_tabcontainer_applied.valid = false;
+
     if (!isVisible()) {
         m_need_render = true;
         return;
@@ -1128,22 +1136,33 @@ void FbWinFrame::applyTitlebar() {
 
     int f = m_state.focused;
     int alpha = getAlpha(f);
-    m_titlebar.setAlpha(alpha);
-    m_label.setAlpha(alpha);
 
     if (m_tabmode != INTERNAL) {
-        m_label.setGC(theme()->iconbarTheme()->text().textGC());
-        m_label.setJustify(theme()->iconbarTheme()->text().justify());
+        // the text color changes with the focus even on a shared background
+        const FbTk::TextTheme &text = theme()->iconbarTheme()->text();
+        if (m_label.gc() != text.textGC()) {
+            m_label.setGC(text.textGC());
+            m_dirty |= DIRTY_LABEL;
+        }
+        m_label.setJustify(text.justify());
 
-        bg_pm_or_color(m_label, m_label_face.pm[f], m_label_face.color[f]);
+        if (applyFace(m_label, m_label_applied,
+                      m_label_face.pm[f], m_label_face.color[f], alpha))
+            m_dirty |= DIRTY_LABEL;
+        else if (m_dirty & DIRTY_LABEL)
+            m_label.updateBackground(false); // text is part of the background
     }
 
-    bg_pm_or_color(m_titlebar, m_title_face.pm[f], m_title_face.color[f]);
+    if (applyFace(m_titlebar, m_title_applied,
+                  m_title_face.pm[f], m_title_face.color[f], alpha))
+        m_dirty |= DIRTY_TITLE;
     applyButtons();
 }
 
 
 void FbWinFrame::renderHandles() {
+    m_handle_applied.valid = m_grip_applied.valid = false;
+
     if (!m_use_handle)
         return;
 
@@ -1178,14 +1197,17 @@ void FbWinFrame::applyHandles() {
     bool f = m_state.focused;
     int alpha = getAlpha(f);
 
-    m_handle.setAlpha(alpha);
-    bg_pm_or_color(m_handle, m_handle_face.pm[f], m_handle_face.color[f]);
+    if (applyFace(m_handle, m_handle_applied,
+                  m_handle_face.pm[f], m_handle_face.color[f], alpha))
+        m_dirty |= DIRTY_HANDLE;
 
-    m_grip_left.setAlpha(alpha);
-    m_grip_right.setAlpha(alpha);
-
-    bg_pm_or_color(m_grip_left, m_grip_face.pm[f], m_grip_face.color[f]);
-    bg_pm_or_color(m_grip_right, m_grip_face.pm[f], m_grip_face.color[f]);
+    // both grips share the face, so the left one keeps track for both
+    if (applyFace(m_grip_left, m_grip_applied,
+                  m_grip_face.pm[f], m_grip_face.color[f], alpha)) {
+        m_grip_right.setAlpha(alpha);
+        bg_pm_or_color(m_grip_right, m_grip_face.pm[f], m_grip_face.color[f]);
+        m_dirty |= DIRTY_GRIPS;
+    }
 }
 
 void FbWinFrame::renderButtons() {
@@ -1214,6 +1236,10 @@ void FbWinFrame::renderButtons() {
 }
 
 void FbWinFrame::applyButtons() {
+    // WinButtons pick their own pictures from the focus state, so these
+    // are always applied
+    m_dirty |= DIRTY_BUTTONS;
+
     // setup left and right buttons
     for (size_t i=0; i < m_buttons_left.size(); ++i)
         applyButton(*m_buttons_left[i]);
@@ -1222,6 +1248,68 @@ void FbWinFrame::applyButtons() {
         applyButton(*m_buttons_right[i]);
 }
 
+bool FbWinFrame::applyFace(FbTk::FbWindow &win, Applied &applied,
+                           Pixmap pm, const FbTk::Color &color, int alpha) {
+    if (applied.valid && applied.pm == pm && applied.alpha == alpha &&
+        (pm != None || applied.pixel == color.pixel()))
+        return false;
+
+    win.setAlpha(alpha);
+    bg_pm_or_color(win, pm, color);
+
+    applied.pm = pm;
+    applied.pixel = color.pixel();
+    applied.alpha = alpha;
+    applied.valid = true;
+    return true;
+}
+
+void FbWinFrame::redrawDirty() {
+    unsigned int dirty = m_dirty;
+    m_dirty = 0;
+
+    // children with a ParentRelative background show their parent's
+    if (dirty & DIRTY_TITLE) {
+        if (m_label_applied.pm == ParentRelative)
+            dirty |= DIRTY_LABEL;
+        if (m_tabcontainer_applied.pm == ParentRelative)
+            dirty |= DIRTY_TABCONTAINER;
+    }
+    if ((dirty & DIRTY_HANDLE) && m_grip_applied.pm == ParentRelative)
+        dirty |= DIRTY_GRIPS;
+
+    if (m_use_titlebar) {
+        if (isVisible() && !m_tab_container.empty()) {
+            if (dirty & DIRTY_TABS)
+                m_tab_container.clear();
+            else if (dirty & DIRTY_TABCONTAINER)
+                m_tab_container.FbTk::FbWindow::clear();
+            if (dirty & DIRTY_LABEL)
+                m_label.clear();
+            if (dirty & DIRTY_TITLE)
+                m_titlebar.clear();
+        }
+        if (dirty & DIRTY_BUTTONS) {
+            forAll(m_buttons_left, mem_fn(&FbTk::Button::clear));
+            forAll(m_buttons_right, mem_fn(&FbTk::Button::clear));
+        }
+    } else if (m_tabmode == EXTERNAL && m_use_tabs) {
+        if (dirty & DIRTY_TABS)
+            m_tab_container.clear();
+        else if (dirty & DIRTY_TABCONTAINER)
+            m_tab_container.FbTk::FbWindow::clear();
+    }
+
+    if (m_use_handle) {
+        if (dirty & DIRTY_HANDLE)
+            m_handle.clear();
+        if (dirty & DIRTY_GRIPS) {
+            m_grip_left.clear();
+            m_grip_right.clear();
+        }
+    }
+}
+
 void FbWinFrame::init() {
 
     if (theme()->handleWidth() == 0)
@@ -1288,9 +1376,22 @@ void FbWinFrame::applyTabContainer() {
 
     FbTk::Container& tabs = tabcontainer();
     FbWinFrame::Face& face = m_tabcontainer_face;
+    int f = m_state.focused;
+    int alpha = getAlpha(f);
+
+    // the label buttons follow the focus of their clients by themselves,
+    // they only need a new theme when they were rendered or the alpha
+    // they take from the container changed
+    const bool retheme = !m_tabcontainer_applied.valid ||
+                         m_tabcontainer_applied.alpha != alpha;
+
+    if (applyFace(tabs, m_tabcontainer_applied, face.pm[f], face.color[f], alpha))
+        m_dirty |= DIRTY_TABCONTAINER;
+
+    if (!retheme)
+        return;
 
-    tabs.setAlpha(getAlpha(m_state.focused));
-    bg_pm_or_color(tabs, face.pm[m_state.focused], face.color[m_state.focused]);
+    m_dirty |= DIRTY_TABS;
 
     // and the labelbuttons in it
     FbTk::Container::ItemList::iterator btn_it = m_tab_container.begin();
@@ -274,6 +274,8 @@ private:
     void applyHandles();
     void applyTabContainer(); // and label buttons
     void applyButtons(); // only called within applyTitlebar
+    /// clear the windows whose background changed since the last applyAll
+    void redrawDirty();
 
 #if 0
     void getCurrentFocusPixmap(Pixmap &label_pm, Pixmap &title_pm,
@@ -342,6 +344,38 @@ private:
     Face m_grip_face;
     BtnFace m_button_face;
 
+    /// background and alpha last set on a window, so a focus change that
+    /// doesn't change them doesn't set or clear them again
+    struct Applied {
+        Applied(): pm(None), pixel(0), alpha(255), valid(false) { }
+        Pixmap pm;
+        unsigned long pixel;
+        int alpha;
+        bool valid; ///< false once the faces are rendered again
+    };
+
+    /// @return true if the window got a new background
+    bool applyFace(FbTk::FbWindow &win, Applied &applied,
+                   Pixmap pm, const FbTk::Color &color, int alpha);
+
+    Applied m_title_applied;
+    Applied m_label_applied;
+    Applied m_tabcontainer_applied;
+    Applied m_handle_applied;
+    Applied m_grip_applied;
+
+    /// windows to clear in redrawDirty()
+    enum DirtyPart {
+        DIRTY_TITLE = 1 << 0,
+        DIRTY_LABEL = 1 << 1,
+        DIRTY_TABCONTAINER = 1 << 2,
+        DIRTY_TABS = 1 << 3, ///< the label buttons in the tab container
+        DIRTY_BUTTONS = 1 << 4,
+        DIRTY_HANDLE = 1 << 5,
+        DIRTY_GRIPS = 1 << 6
+    };
+    unsigned int m_dirty;
+
     //@}
 
     TabMode m_tabmode;
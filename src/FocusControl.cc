@@ -477,7 +477,10 @@ void FocusControl::removeClient(WinClient &client) {
 
     m_focused_list.remove(client);
     m_creation_order_list.remove(client);
-    client.screen().clientListSig().emit(client.screen());
+    // a popup dying before its grace period ran out was never published
+    FluxboxWindow *fbwin = client.fbwindow();
+    if (!fbwin || !client.screen().isDeferred(*fbwin))
+        client.screen().updateClientList();
 }
 
 void FocusControl::removeWindow(Focusable &win) {
@@ -492,7 +495,9 @@ void FocusControl::removeWindow(Focusable &win) {
 
     m_focused_win_list.remove(win);
     m_creation_order_win_list.remove(win);
-    win.screen().clientListSig().emit(win.screen());
+    FluxboxWindow *fbwin = win.fbwindow();
+    if (!fbwin || !win.screen().forgetDeferred(*fbwin))
+        win.screen().updateClientList();
 }
 
 void FocusControl::shutdown() {
@@ -74,7 +74,8 @@ const FocusableList *FocusableList::getListFromOptions(BScreen &scr, int opts) {
 }
 
 FocusableList::FocusableList(BScreen &scr, const string & pat):
-    m_parent(0), m_screen(scr) {
+    m_parent(0), m_screen(scr),
+    m_deps(0) {
 
     int options = 0;
     string pattern;
@@ -87,12 +88,19 @@ FocusableList::FocusableList(BScreen &scr, const string & pat):
 
 FocusableList::FocusableList(BScreen &scr, const FocusableList &parent,
                              const string & pat):
-    m_pat(new ClientPattern(pat.c_str())), m_parent(&parent), m_screen(scr) {
+    m_pat(new ClientPattern(pat.c_str())), m_parent(&parent), m_screen(scr),
+    m_deps(0) {
 
     init();
 }
 
 void FocusableList::init() {
+    for (int prop = ClientPattern::TITLE; prop <= ClientPattern::HORZMAX; ++prop) {
+        ClientPattern::WinProperty p = static_cast<ClientPattern::WinProperty>(prop);
+        if (m_pat->dependsOn(p))
+            m_deps |= signalsFor(p);
+    }
+
     addMatching();
 
     join(m_parent->addSig(), FbTk::MemFun(*this, &FocusableList::parentWindowAdded));
@@ -151,7 +159,7 @@ void FocusableList::parentWindowRemoved(Focusable *win) {
 void FocusableList::checkUpdate(Focusable &win) {
     if (contains(win)) {
         if (!m_pat->match(win)) {
-            m_list.remove(&win);
+            erase(win);
             m_pat->removeMatch();
             m_removesig.emit(&win);
         }
@@ -164,24 +172,50 @@ void FocusableList::checkUpdate(Focusable &win) {
 
 // returns whether or not the window was moved
 bool FocusableList::insertFromParent(Focusable &win) {
-    const Focusables &list = m_parent->clientList();
-    Focusables::const_iterator p_it = list.begin(), p_it_end = list.end();
-    Focusables::iterator our_it = m_list.begin(), our_it_end = m_list.end();
-    // walk through our list looking for corresponding entries in
-    // parent's list, until we find the window that moved
-    for (; our_it != our_it_end && p_it != p_it_end; ++p_it) {
-        if (*p_it == &win) {
-            if (*our_it == &win) // win didn't move in our list
-                return false;
-            m_list.remove(&win);
-            m_list.insert(our_it, &win);
-            return true;
+    Focusables::iterator pos = m_list.end();
+
+    Index::const_iterator p_pos = m_parent->m_index.find(&win);
+    if (p_pos != m_parent->m_index.end()) {
+        // we keep the parent's order, so win belongs right after the
+        // closest window before it in the parent list that we also have
+        const Focusables &list = m_parent->clientList();
+        Focusables::const_iterator p_it = p_pos->second;
+        pos = m_list.begin();
+        while (p_it != list.begin()) {
+            --p_it;
+            Index::iterator our_it = m_index.find(*p_it);
+            if (our_it != m_index.end()) {
+                pos = our_it->second;
+                ++pos;
+                break;
+            }
         }
-        if (*p_it == *our_it)
-            ++our_it;
     }
-    m_list.remove(&win);
-    m_list.push_back(&win);
+
+    Index::iterator it = m_index.find(&win);
+    if (it != m_index.end() && it->second == pos)
+        return false; // win didn't move in our list
+
+    place(pos, win);
+    return true;
+}
+
+void FocusableList::place(Focusables::iterator pos, Focusable &win) {
+    Index::iterator it = m_index.find(&win);
+    if (it == m_index.end()) {
+        m_index[&win] = m_list.insert(pos, &win);
+    } else if (it->second != pos) {
+        // splice keeps the iterator valid
+        m_list.splice(pos, m_list, it->second);
+    }
+}
+
+bool FocusableList::erase(Focusable &win) {
+    Index::iterator it = m_index.find(&win);
+    if (it == m_index.end())
+        return false;
+    m_list.erase(it->second);
+    m_index.erase(it);
     return true;
 }
 
@@ -193,7 +227,7 @@ void FocusableList::addMatching() {
     Focusables::const_iterator it = list.begin(), it_end = list.end();
     for (; it != it_end; ++it) {
         if (m_pat->match(**it)) {
-            m_list.push_back(*it);
+            place(m_list.end(), **it);
             m_pat->addMatch();
         }
         attachSignals(**it);
@@ -201,13 +235,13 @@ void FocusableList::addMatching() {
 }
 
 void FocusableList::pushFront(Focusable &win) {
-    m_list.push_front(&win);
+    place(m_list.begin(), win);
     attachSignals(win);
     m_addsig.emit(&win);
 }
 
 void FocusableList::pushBack(Focusable &win) {
-    m_list.push_back(&win);
+    place(m_list.end(), win);
     attachSignals(win);
     m_addsig.emit(&win);
 }
@@ -217,8 +251,7 @@ void FocusableList::moveToFront(Focusable &win) {
     if (!contains(win))
         return;
 
-    m_list.remove(&win);
-    m_list.push_front(&win);
+    place(m_list.begin(), win);
     m_ordersig.emit(&win);
 }
 
@@ -227,21 +260,15 @@ void FocusableList::moveToBack(Focusable &win) {
     if (!contains(win))
         return;
 
-    m_list.remove(&win);
-    m_list.push_back(&win);
+    place(m_list.end(), win);
     m_ordersig.emit(&win);
 }
 
 void FocusableList::remove(Focusable &win) {
-    // if the window isn't already in this list, we could send a bad signal
-    bool contained = contains(win);
-
     m_signal_map.erase(&win);
-    if (!contained) {
-        return;
-    }
-    m_list.remove(&win);
-    m_removesig.emit(&win);
+    // if the window isn't already in this list, we could send a bad signal
+    if (erase(win))
+        m_removesig.emit(&win);
 }
 
 void FocusableList::updateTitle(Focusable& win) {
@@ -260,20 +287,24 @@ void FocusableList::attachSignals(Focusable &win) {
     if (! tracker) {
         // we have not attached to this window yet
         tracker.reset(new SignalTracker);
-        tracker->join(win.titleSig(), MemFunSelectArg1(*this, &FocusableList::updateTitle));
+        if (m_deps & TITLE_SIGNALS)
+            tracker->join(win.titleSig(), MemFunSelectArg1(*this, &FocusableList::updateTitle));
         tracker->join(win.dieSig(), MemFun(*this, &FocusableList::remove));
-        if(fbwin) {
+        if (fbwin && (m_deps & STATE_SIGNALS)) {
             tracker->join(fbwin->workspaceSig(), MemFun(*this, &FocusableList::windowUpdated));
             tracker->join(fbwin->stateSig(), MemFun(*this, &FocusableList::windowUpdated));
             tracker->join(fbwin->layerSig(), MemFun(*this, &FocusableList::windowUpdated));
             // TODO: can't watch (head=...) yet
         }
+        if (fbwin && (m_deps & PROPERTY_SIGNALS))
+            tracker->join(fbwin->propertySig(), MemFun(*this, &FocusableList::windowUpdated));
     }
 }
 
 void FocusableList::reset() {
     m_signal_map.clear();
     m_list.clear();
+    m_index.clear();
     m_pat->resetMatches();
     if (m_parent)
         addMatching();
@@ -281,9 +312,7 @@ void FocusableList::reset() {
 }
 
 bool FocusableList::contains(const Focusable &win) const {
-    Focusables::const_iterator it = m_list.begin(), it_end = m_list.end();
-    it = std::find(it, it_end, &win);
-    return (it != it_end);
+    return m_index.find(&win) != m_index.end();
 }
 
 Focusable *FocusableList::find(const ClientPattern &pat) const {
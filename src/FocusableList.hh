@@ -29,8 +29,10 @@
 #include "ClientPattern.hh"
 
 #include <list>
+#include <map>
 #include <string>
 #include <memory>
+#include <unordered_map>
 
 class BScreen;
 class Focusable;
@@ -48,7 +50,37 @@ public:
         STATIC_ORDER = 0x02  ///< use creation order instead of focused order
     };
 
-    FocusableList(BScreen &scr): m_parent(0), m_screen(scr) { }
+    /// window signals after which a pattern property may match differently
+    enum {
+        TITLE_SIGNALS = 0x01, ///< Focusable::titleSig
+        STATE_SIGNALS = 0x02, ///< state, workspace and layer signals
+        PROPERTY_SIGNALS = 0x04 ///< FluxboxWindow::propertySig
+    };
+
+    /// @return the signals to watch for patterns looking at prop
+    static int signalsFor(ClientPattern::WinProperty prop) {
+        switch (prop) {
+        case ClientPattern::TITLE:
+            return TITLE_SIGNALS;
+        case ClientPattern::CLASS:
+        case ClientPattern::NAME:
+        case ClientPattern::ROLE:
+        case ClientPattern::TRANSIENT:
+            return TITLE_SIGNALS | PROPERTY_SIGNALS;
+        case ClientPattern::XPROP:
+            return PROPERTY_SIGNALS;
+        case ClientPattern::SCREEN:
+            // a client never changes screens, this only keeps the old
+            // behaviour of checking again along with the state
+        case ClientPattern::URGENT:
+            // AttentionNoticeHandler emits stateSig when it changes
+        default:
+            return STATE_SIGNALS;
+        }
+    }
+
+    FocusableList(BScreen &scr):
+        m_parent(0), m_screen(scr), m_deps(0) { }
     FocusableList(BScreen &scr, const std::string & pat);
     FocusableList(BScreen &scr, const FocusableList &parent,
                   const std::string & pat);
@@ -63,7 +95,7 @@ public:
     void moveToBack(Focusable &win);
     void remove(Focusable &win);
 
-    /// accessor for list
+    /// accessor for list, use the functions above to modify it
     Focusables &clientList() { return m_list; }
     const Focusables &clientList() const { return m_list; }
 
@@ -89,6 +121,10 @@ private:
     void addMatching();
     void checkUpdate(Focusable &win);
     bool insertFromParent(Focusable &win);
+    /// insert win before pos, or move it there if we have it already
+    void place(Focusables::iterator pos, Focusable &win);
+    /// @return false if win wasn't in the list
+    bool erase(Focusable &win);
     void attachSignals(Focusable &win);
     void reset();
     void workspaceChanged(BScreen &screen);
@@ -105,7 +141,13 @@ private:
     std::unique_ptr<ClientPattern> m_pat;
     const FocusableList *m_parent;
     BScreen &m_screen;
-    std::list<Focusable *> m_list;
+    Focusables m_list;
+    /// position of each window in m_list, for O(1) lookup and reordering
+    typedef std::unordered_map<const Focusable *, Focusables::iterator> Index;
+    Index m_index;
+    /// the signals that can change what the pattern matches, we only
+    /// re-match when one of them was emitted (see signalsFor())
+    int m_deps;
 
     FbTk::Signal<Focusable *> m_ordersig, m_addsig, m_removesig;
     FbTk::Signal<> m_resetsig;
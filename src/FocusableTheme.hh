@@ -30,13 +30,17 @@ template <typename BaseTheme>
 class FocusableTheme: public FbTk::ThemeProxy<BaseTheme> {
 public:
     FocusableTheme(Focusable &win, FbTk::ThemeProxy<BaseTheme> &focused,
-                   FbTk::ThemeProxy<BaseTheme> &unfocused):
+                   FbTk::ThemeProxy<BaseTheme> &unfocused,
+                   bool follow_attention = true):
         m_win(win), m_focused_theme(focused), m_unfocused_theme(unfocused) {
 
         m_signals.join(m_win.focusSig(),
                 FbTk::MemFunIgnoreArgs(m_reconfig_sig, &FbTk::Signal<>::emit));
-        m_signals.join(m_win.attentionSig(),
-                FbTk::MemFunIgnoreArgs(m_reconfig_sig, &FbTk::Signal<>::emit));
+        // users which can switch between the looks on their own don't
+        // need a full reconfigure on every attention blink
+        if (follow_attention)
+            m_signals.join(m_win.attentionSig(),
+                    FbTk::MemFunIgnoreArgs(m_reconfig_sig, &FbTk::Signal<>::emit));
         m_signals.join(m_focused_theme.reconfigSig(),
                 FbTk::MemFun(m_reconfig_sig, &FbTk::Signal<>::emit));
         m_signals.join(m_unfocused_theme.reconfigSig(),
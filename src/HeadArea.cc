@@ -25,12 +25,14 @@
 #include <algorithm>
 #include <iostream>
 
-HeadArea::HeadArea() : m_available_workspace_area(new Strut(0,0,0,0,0)) {
+HeadArea::HeadArea() : m_available_workspace_area(new Strut(0,0,0,0,0)),
+    m_dirty(false) {
 }
 
 Strut *HeadArea::requestStrut(int head, int left, int right, int top, int bottom, Strut* next) {
     Strut *str = new Strut(head, left, right, top, bottom, next);
     m_strutlist.push_back(str);
+    m_dirty = true;
     return str;
 }
 
@@ -48,6 +50,7 @@ void HeadArea::clearStrut(Strut *str) {
 
     m_strutlist.erase(pos);
     delete str;
+    m_dirty = true;
 }
 
 /// helper class for for_each in HeadArea::updateAvailableWorkspaceArea()
@@ -70,18 +73,22 @@ private:
 } // end anonymous namespace
 
 bool HeadArea::updateAvailableWorkspaceArea() {
-    // find max of left, right, top and bottom and set avaible workspace area
+    // nothing on this head changed
+    if (!m_dirty)
+        return false;
+    m_dirty = false;
 
-    // clear old area
-    Strut oldarea = *(m_available_workspace_area.get());
-    m_available_workspace_area.reset(new Strut(0, 0, 0, 0, 0));
-    
-    // calculate max area
+    // find max of left, right, top and bottom and set avaible workspace area
+    Strut area(0, 0, 0, 0, 0);
     std::for_each(m_strutlist.begin(),
              m_strutlist.end(),
-             MaxArea(*m_available_workspace_area.get()));
+             MaxArea(area));
 
     // only notify if the area changed
-    return !(oldarea == *(m_available_workspace_area.get()));
+    if (area == *m_available_workspace_area)
+        return false;
+
+    *m_available_workspace_area = area;
+    return true;
 }
 
@@ -34,6 +34,7 @@ public:
 
     Strut *requestStrut(int head, int left, int right, int top, int bottom, Strut* next = 0);
     void clearStrut(Strut *str);
+    /// @return true if the area changed, only looks at the struts if they did
     bool updateAvailableWorkspaceArea();
     const Strut *availableWorkspaceArea() const {
         return m_available_workspace_area.get();
@@ -42,6 +43,7 @@ public:
 private:
     std::unique_ptr<Strut> m_available_workspace_area;
     std::list<Strut*> m_strutlist;
+    bool m_dirty; ///< struts changed since the last update
 };
 
 #endif // HEADAREA_HH
@@ -47,10 +47,13 @@ IconButton::IconButton(const FbTk::FbWindow &parent,
     m_icon_window(*this, 1, 1, 1, 1,
                   ExposureMask |EnterWindowMask | LeaveWindowMask |
                   ButtonPressMask | ButtonReleaseMask),
+    m_icon_pixmap(win.screen().imageControl()),
+    m_icon_mask(win.screen().imageControl()),
     m_use_pixmap(true),
     m_has_tooltip(false),
     m_theme(win, focused_theme, unfocused_theme),
-    m_pm(win.screen().imageControl()) {
+    m_focused_pm(win.screen().imageControl()),
+    m_unfocused_pm(win.screen().imageControl()) {
 
     m_title_update_timer.setTimeout(updateLaziness());
     m_title_update_timer.fireOnce(true);
@@ -63,11 +66,13 @@ IconButton::IconButton(const FbTk::FbWindow &parent,
         m_signals.join(m_win.fbwindow()->stateSig(),
                        MemFunIgnoreArgs(*this, &IconButton::clientTitleChanged));
 
+    // both backgrounds are rendered already, a focus change only has to
+    // pick the other one
     m_signals.join(m_win.focusSig(),
-                   MemFunIgnoreArgs(*this, &IconButton::reconfigAndClear));
+                   MemFunIgnoreArgs(*this, &IconButton::applyAndClear));
 
     m_signals.join(m_win.attentionSig(),
-                   MemFunIgnoreArgs(*this, &IconButton::reconfigAndClear));
+                   MemFunIgnoreArgs(*this, &IconButton::applyAndClear));
 
     FbTk::EventManager::instance()->add(*this, m_icon_window);
 
@@ -84,7 +89,7 @@ IconButton::~IconButton() {
 
 void IconButton::exposeEvent(XExposeEvent &event) {
     if (m_icon_window == event.window)
-        m_icon_window.clear();
+        m_icon_window.clearArea(event.x, event.y, event.width, event.height);
     else
         FbTk::TextButton::exposeEvent(event);
 }
@@ -102,19 +107,26 @@ void IconButton::leaveNotifyEvent(XCrossingEvent &ev) {
 void IconButton::moveResize(int x, int y,
                             unsigned int width, unsigned int height) {
 
+    // the icon window is always smaller than the button, so compare with
+    // our old size to find out whether backgrounds and icon need an update
+    const bool resized = width != FbTk::Button::width() ||
+                         height != FbTk::Button::height();
+
     FbTk::TextButton::moveResize(x, y, width, height);
 
-    if (m_icon_window.width() != FbTk::Button::width() ||
-        m_icon_window.height() != FbTk::Button::height()) {
+    if (resized) {
         reconfigTheme();
         refreshEverything(false); // update icon window
     }
 }
 
 void IconButton::resize(unsigned int width, unsigned int height) {
+    const bool resized = width != FbTk::Button::width() ||
+                         height != FbTk::Button::height();
+
     FbTk::TextButton::resize(width, height);
-    if (m_icon_window.width() != FbTk::Button::width() ||
-        m_icon_window.height() != FbTk::Button::height()) {
+
+    if (resized) {
         reconfigTheme();
         refreshEverything(false); // update icon window
     }
@@ -122,7 +134,7 @@ void IconButton::resize(unsigned int width, unsigned int height) {
 
 void IconButton::showTooltip() {
    int xoffset = 1;
-   if (m_icon_pixmap.drawable() != 0)
+   if (m_icon_pixmap != 0)
        xoffset = m_icon_window.x() + m_icon_window.width() + 1;
 
     if (FbTk::TextButton::textExceeds(xoffset))
@@ -133,6 +145,7 @@ void IconButton::showTooltip() {
 
 void IconButton::clear() {
     setupWindow();
+    FbTk::TextButton::clear();
 }
 
 void IconButton::clearArea(int x, int y,
@@ -151,6 +164,24 @@ void IconButton::setPixmap(bool use) {
 
 void IconButton::reconfigTheme() {
 
+    // buttons of the same size and state share their background through
+    // the image cache, for most textures already when they're as high
+    FbTk::ImageControl &ctrl = m_win.screen().imageControl();
+    const FbTk::Texture &focused = m_theme.focusedTheme()->texture();
+    const FbTk::Texture &unfocused = m_theme.unfocusedTheme()->texture();
+
+    m_focused_pm.reset(focused.usePixmap() ?
+                       ctrl.renderBackground(width(), height(), focused, orientation()) :
+                       0);
+    m_unfocused_pm.reset(unfocused.usePixmap() ?
+                         ctrl.renderBackground(width(), height(), unfocused, orientation()) :
+                         0);
+
+    applyTheme();
+}
+
+void IconButton::applyTheme() {
+
     setFont(m_theme->text().font());
     setGC(m_theme->text().textGC());
     setBorderWidth(m_theme->border().width());
@@ -158,15 +189,13 @@ void IconButton::reconfigTheme() {
     setJustify(m_theme->text().justify());
     setAlpha(parent()->alpha());
 
-    if (m_theme->texture().usePixmap()) {
-        m_pm.reset(m_win.screen().imageControl().renderImage(
-                           width(), height(), m_theme->texture(),
-                           orientation()));
-        setBackgroundPixmap(m_pm);
-    } else{
-        m_pm.reset(0);
+    const bool focused = m_win.isFocused() || m_win.getAttentionState();
+    Pixmap pm = focused ? m_focused_pm : m_unfocused_pm;
+
+    if (m_theme->texture().usePixmap() && pm != 0)
+        setBackgroundPixmap(pm);
+    else
         setBackgroundColor(m_theme->texture().color());
-    }
 
     updateBackground(false);
 }
@@ -176,10 +205,16 @@ void IconButton::reconfigAndClear() {
     clear();
 }
 
+void IconButton::applyAndClear() {
+    applyTheme();
+    clear();
+}
+
 void IconButton::refreshEverything(bool setup) {
 
     Display *display = FbTk::App::instance()->display();
     int screen = m_win.screen().screenNumber();
+    FbTk::ImageControl &ctrl = m_win.screen().imageControl();
 
     if (m_use_pixmap && m_win.icon().pixmap().drawable() != None) {
         // setup icon window
@@ -202,28 +237,29 @@ void IconButton::refreshEverything(bool setup) {
 
         m_icon_window.moveResize(iconx, icony, neww, newh);
 
-        m_icon_pixmap.copy(m_win.icon().pixmap().drawable(),
-                           DefaultDepth(display, screen), screen);
-        m_icon_pixmap.scale(m_icon_window.width(), m_icon_window.height());
+        // the scaled icon only changes with the client icon or our size,
+        // so title changes get the very same pixmap back
+        m_icon_pixmap.reset(ctrl.scaledPixmap(m_win.icon().pixmap().drawable(),
+                                              m_icon_window.width(),
+                                              m_icon_window.height(),
+                                              DefaultDepth(display, screen),
+                                              orientation()));
 
-        // rotate the icon or not?? lets go not for now, and see what they say...
-        // need to rotate mask too if we do do this
-        m_icon_pixmap.rotate(orientation());
-
-        m_icon_window.setBackgroundPixmap(m_icon_pixmap.drawable());
+        m_icon_window.setBackgroundPixmap(m_icon_pixmap);
     } else {
         // no icon pixmap
         m_icon_window.move(0, 0);
         m_icon_window.hide();
-        m_icon_pixmap = 0;
+        m_icon_pixmap.reset(0);
     }
 
-    if(m_icon_pixmap.drawable() && m_win.icon().mask().drawable() != None) {
-        m_icon_mask.copy(m_win.icon().mask().drawable(), 0, 0);
-        m_icon_mask.scale(m_icon_pixmap.width(), m_icon_pixmap.height());
-        m_icon_mask.rotate(orientation());
+    if (m_icon_pixmap != 0 && m_win.icon().mask().drawable() != None) {
+        m_icon_mask.reset(ctrl.scaledPixmap(m_win.icon().mask().drawable(),
+                                            m_icon_window.width(),
+                                            m_icon_window.height(),
+                                            0, orientation()));
     } else
-        m_icon_mask = 0;
+        m_icon_mask.reset(0);
 
 #ifdef SHAPE
 
@@ -231,7 +267,7 @@ void IconButton::refreshEverything(bool setup) {
                       m_icon_window.drawable(),
                       ShapeBounding,
                       0, 0,
-                      m_icon_mask.drawable(),
+                      m_icon_mask,
                       ShapeSet);
 
 #endif // SHAPE
@@ -258,14 +294,14 @@ void IconButton::setupWindow() {
     FbTk::FbString title = m_win.title().logical();
     if (m_win.fbwindow() && m_win.fbwindow()->isIconic())
         title = IconbarTool::iconifiedPrefix() + title + IconbarTool::iconifiedSuffix();
+    // only clears where the old and the new title are
     setText(title);
-    FbTk::TextButton::clear();
 }
 
 void IconButton::drawText(int x, int y, FbTk::FbDrawable *drawable) {
 
     // offset text
-    if (m_icon_pixmap.drawable() != 0)
+    if (m_icon_pixmap != 0)
         FbTk::TextButton::drawText(m_icon_window.x() + m_icon_window.width() + 1, y, drawable);
     else
         FbTk::TextButton::drawText(1, y, drawable);
@@ -295,7 +331,7 @@ unsigned int IconButton::preferredWidth() const {
     unsigned int r2 = TextButton::preferredWidth();
     that->setFont(that->m_theme->text().font());
     r = std::max(r, r2);
-    if (m_icon_pixmap.drawable())
+    if (m_icon_pixmap != 0)
         r += m_icon_window.width() + 1;
     return r;
 }
@@ -76,6 +76,9 @@ protected:
     void drawText(int x, int y, FbTk::FbDrawable *drawable_override);
 private:
     void reconfigAndClear();
+    /// use the pre-rendered background of the current focus state
+    void applyTheme();
+    void applyAndClear();
     void setupWindow();
 
     /// Refresh all pixmaps and windows
@@ -86,15 +89,17 @@ private:
 
     Focusable &m_win;
     FbTk::FbWindow m_icon_window;
-    FbTk::FbPixmap m_icon_pixmap;
-    FbTk::FbPixmap m_icon_mask;
+    // scaled icon, shared through the image control
+    FbTk::CachedPixmap m_icon_pixmap;
+    FbTk::CachedPixmap m_icon_mask;
     bool m_use_pixmap;
     /// whether or not this instance has the tooltip attention 
     /// i.e if it got enter notify
     bool m_has_tooltip;
     FocusableTheme<IconbarTheme> m_theme;
-    // cached pixmaps
-    FbTk::CachedPixmap m_pm;
+    // cached backgrounds, one per focus state
+    FbTk::CachedPixmap m_focused_pm;
+    FbTk::CachedPixmap m_unfocused_pm;
     FbTk::SignalTracker m_signals;
     FbTk::Signal<> m_title_changed;
     FbTk::Timer m_title_update_timer;
@@ -533,6 +533,9 @@ void IconbarTool::renderTheme(int alpha) {
 
 void IconbarTool::renderTheme() {
 
+    // the buttons pick up the container alpha while reconfiguring
+    m_icon_container.setAlpha(m_alpha);
+
     // update button sizes before we get max width per client!
     updateSizing();
 
@@ -542,19 +545,21 @@ void IconbarTool::renderTheme() {
         m_icon_container.setBackgroundColor(m_theme.emptyTexture().color());
     } else {
         m_empty_pm.reset(m_screen.imageControl().
-                          renderImage(m_icon_container.width(),
+                          renderBackground(m_icon_container.width(),
                                       m_icon_container.height(),
                                       m_theme.emptyTexture(), orientation()));
         m_icon_container.setBackgroundPixmap(m_empty_pm);
     }
 
-    m_icon_container.setAlpha(m_alpha);
-
-    // update buttons
+    // update buttons, updateSizing() rendered their backgrounds already
     IconMap::iterator icon_it = m_icons.begin();
     const IconMap::iterator icon_it_end = m_icons.end();
-    for (; icon_it != icon_it_end; ++icon_it)
-        renderButton(*icon_it->second);
+    for (; icon_it != icon_it_end; ++icon_it) {
+        IconButton &button = *icon_it->second;
+        button.setPixmap(*m_rc_use_pixmap);
+        button.setTextPadding(*m_rc_client_padding);
+        button.clear(); // the clear also updates transparent
+    }
 
 }
 
@@ -23,6 +23,11 @@
 #define MINOVERLAPPLACEMENT_HH
 
 #include "ScreenPlacement.hh"
+#include "WindowLayout.hh"
+
+#include <vector>
+
+class BScreen;
 
 class MinOverlapPlacement: public PlacementStrategy {
 public:
@@ -31,6 +36,18 @@ public:
     bool placeWindow(const FluxboxWindow &win, int head,
                      int &place_x, int &place_y);
 
+    /**
+     * Fills the model with the windows on workspace (or stuck), in the
+     * order they are considered for placement.
+     */
+    static void workspaceModel(const BScreen &screen, unsigned int workspace,
+                               std::vector<FluxboxWindow *> &windows,
+                               std::vector<WindowLayout::Window> &model);
+    static WindowLayout::Window modelOf(const FluxboxWindow &win);
+    /// the extents windows are placed into on head
+    static WindowLayout::Box headBox(const BScreen &screen, int head);
+    static WindowLayout::Order order(const BScreen &screen);
+
 private:
 };
 
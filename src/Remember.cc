@@ -168,6 +168,8 @@ public:
 
     bool ignoreSizeHints_remember;
 
+    bool lightweight_remember;
+
     bool position_remember;
     int x,y;
     bool position_is_x_relative;
@@ -251,6 +253,7 @@ void Application::reset() {
         minimizedstate_remember =
         maximizedstate_remember =
         fullscreenstate_remember =
+        lightweight_remember =
         save_on_close_remember = false;
 }
 
@@ -501,6 +504,8 @@ int parseApp(ifstream &file, Application &app, string *first_line = 0) {
                 had_error = true;
         } else if (str_key == "ignoresizehints") {
             app.ignoreSizeHints_remember = str_label == "yes";
+        } else if (str_key == "lightweight") {
+            app.lightweight_remember = str_label == "yes";
         } else if (str_key == "position") {
             FluxboxWindow::ReferenceCorner r = FluxboxWindow::LEFTTOP;
             // more info about the parameter
@@ -1097,6 +1102,9 @@ void Remember::save() {
         if (a.save_on_close_remember) {
             apps_file << "  [Close]\t{" << ((a.save_on_close)?"yes":"no") << "}" << endl;
         }
+        if (a.lightweight_remember) {
+            apps_file << "  [Lightweight]\t{yes}" << endl;
+        }
         if (a.alpha_remember) {
             if (a.focused_alpha == a.unfocused_alpha)
                 apps_file << "  [Alpha]\t{" << a.focused_alpha << "}" << endl;
@@ -1126,6 +1134,9 @@ bool Remember::isRemembered(WinClient &winclient, Attribute attrib) {
     case REM_IGNORE_SIZEHINTS:
         return app->ignoreSizeHints_remember;
         break;
+    case REM_LIGHTWEIGHT:
+        return app->lightweight_remember;
+        break;
     case REM_POSITION:
         return app->position_remember;
         break;
@@ -1275,6 +1286,9 @@ void Remember::forgetAttrib(WinClient &winclient, Attribute attrib) {
     case REM_IGNORE_SIZEHINTS:
         app->ignoreSizeHints_remember = false;
         break;
+    case REM_LIGHTWEIGHT:
+        app->lightweight_remember = false;
+        break;
     case REM_POSITION:
         app->forgetPosition();
         break;
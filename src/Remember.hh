@@ -76,6 +76,7 @@ public:
         REM_FULLSCREENSTATE,
         REM_FOCUSPROTECTION,
         REM_IGNORE_SIZEHINTS,
+        REM_LIGHTWEIGHT,
         REM_LASTATTRIB // not actually used
     };
 
@@ -60,6 +60,7 @@
 #include "FbTk/MultLayers.hh"
 #include "FbTk/LayerItem.hh"
 #include "FbTk/MacroCommand.hh"
+#include "FbTk/MemoryPool.hh"
 #include "FbTk/StringUtil.hh"
 #include "FbTk/ImageControl.hh"
 #include "FbTk/EventManager.hh"
@@ -144,6 +145,15 @@ using namespace std::placeholders;
 static bool running = true;
 namespace {
 
+// how long a lightweight window may live before the client list learns about it
+const uint64_t CLIENTLIST_GRACE_PERIOD = 500 * FbTk::FbTime::IN_MILLISECONDS;
+
+// (un)docking sends a burst of RandR events, wait until it is over
+const uint64_t RANDR_SETTLE_DELAY = 150 * FbTk::FbTime::IN_MILLISECONDS;
+
+// number of head layouts to remember window positions for
+const size_t MAX_HEAD_LAYOUTS = 8;
+
 int anotherWMRunning(Display *display, XErrorEvent *) {
     _FB_USES_NLS;
     cerr<<_FB_CONSOLETEXT(Screen, AnotherWMRunning,
@@ -216,6 +226,7 @@ BScreen::BScreen(FbTk::ResourceManager &rm,
     m_altname(altscreenname),
     m_focus_control(new FocusControl(*this)),
     m_placement_strategy(new ScreenPlacement(*this)),
+    m_head_layout_saves(0),
     m_opts(opts) {
 
 
@@ -332,6 +343,16 @@ BScreen::BScreen(FbTk::ResourceManager &rm,
     m_tracker.join(focusedWinFrameTheme()->reconfigSig(),
             FbTk::MemFun(*this, &BScreen::focusedWinFrameThemeReconfigured));
 
+    FbTk::RefCount<FbTk::Command<void> > publish_cmd(new FbTk::SimpleCommand<BScreen>(*this, &BScreen::publishClientList));
+    m_clientlist_timer.setTimeout(CLIENTLIST_GRACE_PERIOD);
+    m_clientlist_timer.setCommand(publish_cmd);
+    m_clientlist_timer.fireOnce(true);
+
+    FbTk::RefCount<FbTk::Command<void> > update_size_cmd(new FbTk::SimpleCommand<BScreen>(*this, &BScreen::updateSize));
+    m_randr_timer.setTimeout(RANDR_SETTLE_DELAY);
+    m_randr_timer.setCommand(update_size_cmd);
+    m_randr_timer.fireOnce(true);
+
 
     renderGeomWindow();
     renderPosWindow();
@@ -891,6 +912,11 @@ void BScreen::removeClient(WinClient &client) {
     if (erase_it != m_expecting_groups.end())
         m_expecting_groups.erase(erase_it);
 
+    // the X server may hand this window id to some other client later
+    for (HeadLayouts::iterator it = m_head_layouts.begin();
+            it != m_head_layouts.end(); ++it)
+        it->second.places.erase(client.window());
+
     // the client could be on icon menu so we update it
     //!! TODO: check this with the new icon menu
     //    updateIconMenu();
@@ -1129,6 +1155,10 @@ FluxboxWindow *BScreen::createWindow(Window client) {
         return 0; // dont create a FluxboxWindow for this one
     }
 
+#ifdef DEBUG
+    const FbTk::MemoryPool::Stats pool_before = FbTk::MemoryPool::stats();
+#endif // DEBUG
+
     WinClient *winclient = new WinClient(client, *this);
 
     if (winclient->initial_state == WithdrawnState ||
@@ -1181,7 +1211,16 @@ FluxboxWindow *BScreen::createWindow(Window client) {
     else if (other) // should never happen
         win->moveClientRightOf(*other, *winclient);
 
-    m_clientlist_sig.emit(*this);
+    if (!isDeferred(*win))
+        updateClientList();
+
+#ifdef DEBUG
+    const FbTk::MemoryPool::Stats &pool_after = FbTk::MemoryPool::stats();
+    fbdbg<<"BScreen::createWindow("<<hex<<client<<dec<<"): "
+         <<(pool_after.pooled - pool_before.pooled)<<" pooled, "
+         <<(pool_after.heap - pool_before.heap)<<" heap allocations, "
+         <<pool_after.in_use<<" blocks in use"<<endl;
+#endif // DEBUG
 
     fluxbox->sync(false);
     return win;
@@ -1220,11 +1259,42 @@ FluxboxWindow *BScreen::createWindow(WinClient &client) {
             && win->focus())
         FocusControl::setFocusedWindow(&client);
 
-    m_clientlist_sig.emit(*this);
+    if (!isDeferred(*win))
+        updateClientList();
 
     return win;
 }
 
+void BScreen::updateClientList() {
+    publishClientList();
+}
+
+void BScreen::deferClientList(const FluxboxWindow &win) {
+    m_deferred_windows.insert(&win);
+    if (!m_clientlist_timer.isTiming())
+        m_clientlist_timer.start();
+}
+
+bool BScreen::forgetDeferred(const FluxboxWindow &win) {
+    if (m_deferred_windows.erase(&win) == 0)
+        return false;
+    // nothing left to announce; a workspace still marked dirty just
+    // refreshes its menu once more with the next update
+    if (m_deferred_windows.empty())
+        m_clientlist_timer.stop();
+    return true;
+}
+
+void BScreen::publishClientList() {
+    // this covers whatever was deferred so far
+    m_clientlist_timer.stop();
+    m_deferred_windows.clear();
+    for (Workspaces::iterator it = m_workspaces_list.begin();
+         it != m_workspaces_list.end(); ++it)
+        (*it)->flushClientmenu();
+    m_clientlist_sig.emit(*this);
+}
+
 Strut *BScreen::requestStrut(int head, int left, int right, int top, int bottom) {
     if (head > numHeads() && head != 1) {
         // head does not exist (if head == 1, then numHeads() == 0,
@@ -1594,21 +1664,36 @@ void BScreen::renderPosWindow() {
 }
 
 void BScreen::updateSize() {
+    m_randr_timer.stop();
+
+    // remember the current layout, in case it comes back
+    saveHeadLayout();
+    const HeadLayout old_heads = m_xinerama.heads;
+
     // update xinerama layout
     initXinerama();
 
     // check if window geometry has changed
-    if (rootWindow().updateGeometry()) {
-        // reset background
+    const bool root_changed = rootWindow().updateGeometry();
+    if (!root_changed && old_heads == m_xinerama.heads)
+        return;
+
+    // reset background
+    if (root_changed)
         m_root_theme->reset();
 
-        // send resize notify
-        m_resize_sig.emit(*this);
-        m_workspace_area_sig.emit(*this);
+    // send resize notify
+    m_resize_sig.emit(*this);
+    m_workspace_area_sig.emit(*this);
 
-        // move windows out of inactive heads
-        clearHeads();
-    }
+    // move windows out of inactive heads
+    clearHeads();
+}
+
+void BScreen::deferUpdateSize() {
+    // restart, so it runs after the last event of a burst
+    m_randr_timer.stop();
+    m_randr_timer.start();
 }
 
 
@@ -1711,10 +1796,47 @@ void BScreen::initXinerama() {
     reconfigureStruts();
 }
 
-/* Move windows out of inactive heads */
+void BScreen::saveHeadLayout() {
+    if (!hasXinerama())
+        return;
+
+    SavedHeadLayout &layout = m_head_layouts[m_xinerama.heads];
+    layout.saved = ++m_head_layout_saves;
+    HeadLayoutPlaces &places = layout.places;
+    places.clear();
+
+    for (Workspaces::iterator i = m_workspaces_list.begin();
+            i != m_workspaces_list.end(); ++i) {
+        for (Workspace::Windows::iterator win = (*i)->windowList().begin();
+                win != (*i)->windowList().end(); ++win) {
+
+            FluxboxWindow& w = *(*win);
+            HeadLayoutPlace &place = places[w.clientWindow()];
+            place.head = getHead(w.fbWindow());
+            place.x = w.x();
+            place.y = w.y();
+            place.width = w.width();
+            place.height = w.height();
+        }
+    }
+
+    // forget the oldest layout if there are too many
+    if (m_head_layouts.size() > MAX_HEAD_LAYOUTS) {
+        HeadLayouts::iterator oldest = m_head_layouts.begin();
+        for (HeadLayouts::iterator it = m_head_layouts.begin();
+                it != m_head_layouts.end(); ++it) {
+            if (it->second.saved < oldest->second.saved)
+                oldest = it;
+        }
+        m_head_layouts.erase(oldest);
+    }
+}
+
 void BScreen::clearHeads() {
     if (!hasXinerama()) return;
 
+    HeadLayouts::const_iterator layout = m_head_layouts.find(m_xinerama.heads);
+
     for (Workspaces::iterator i = m_workspaces_list.begin();
             i != m_workspaces_list.end(); ++i) {
         for (Workspace::Windows::iterator win = (*i)->windowList().begin();
@@ -1722,6 +1844,23 @@ void BScreen::clearHeads() {
 
             FluxboxWindow& w = *(*win);
 
+            // back to where it was with these heads
+            if (layout != m_head_layouts.end()) {
+                HeadLayoutPlaces::const_iterator place =
+                    layout->second.places.find(w.clientWindow());
+                if (place != layout->second.places.end()) {
+                    const HeadLayoutPlace &p = place->second;
+                    if (w.isMaximized() || w.isFullscreen()) {
+                        if (p.head != getHead(w.fbWindow()))
+                            w.setOnHead(p.head);
+                    } else if (p.x != w.x() || p.y != w.y() ||
+                               p.width != w.width() || p.height != w.height()) {
+                        w.moveResize(p.x, p.y, p.width, p.height);
+                    }
+                    continue;
+                }
+            }
+
             // check if the window is invisible
             bool invisible = true;
             int j;
@@ -39,6 +39,7 @@
 #include "FbTk/MultLayers.hh"
 #include "FbTk/NotCopyable.hh"
 #include "FbTk/Signal.hh"
+#include "FbTk/Timer.hh"
 #include "FbTk/RelCalcHelper.hh"
 
 #include "FocusControl.hh"
@@ -49,6 +50,7 @@
 #include <fstream>
 #include <memory>
 #include <map>
+#include <set>
 
 class ClientPattern;
 class FbMenu;
@@ -203,6 +205,23 @@ public:
     typedef FbTk::Signal<BScreen&> ScreenSignal;
     /// client list signal
     ScreenSignal &clientListSig() { return m_clientlist_sig; }
+    /// the client list changed, publish it right away
+    void updateClientList();
+    /**
+     * A short lived window (see FluxboxWindow::isLightweight) appeared.
+     * It is only published after a grace period, along with whatever
+     * else was deferred by then.
+     */
+    void deferClientList(const FluxboxWindow &win);
+    /// win appeared since the client list was last published
+    bool isDeferred(const FluxboxWindow &win) const {
+        return m_deferred_windows.find(&win) != m_deferred_windows.end();
+    }
+    /**
+     * win is gone.
+     * @return true if it never got published, so nothing needs updating
+     */
+    bool forgetDeferred(const FluxboxWindow &win);
     /// icon list sig
     ScreenSignal &iconListSig() { return m_iconlist_sig; }
     /// workspace count signal
@@ -387,6 +406,8 @@ public:
     /// that depends on screen size (slit)
     /// (and maximized windows?)
     void updateSize();
+    /// calls updateSize() once a burst of RandR events is over
+    void deferUpdateSize();
 
     // Xinerama-related functions
 
@@ -397,6 +418,8 @@ public:
 
     void initXinerama();
     void clearXinerama();
+    /// moves windows back to where they were the last time this head
+    /// layout was seen, or out of inactive heads
     void clearHeads();
     /// clean up xinerama
 
@@ -474,6 +497,7 @@ private:
     void renderGeomWindow();
     void renderPosWindow();
     void focusedWinFrameThemeReconfigured();
+    void publishClientList();
 
     int getGap(int head, const char type);
     float getXGap(int head);
@@ -486,9 +510,12 @@ private:
 
     FbTk::Signal<BScreen&, FluxboxWindow*, WinClient*> m_focusedwindow_sig;  ///< focused window signal
     ScreenSignal m_resize_sig; ///< resize signal
+    FbTk::Timer m_randr_timer; ///< collects RandR events for updateSize()
     ScreenSignal m_workspace_area_sig; ///< workspace area changed signal
     ScreenSignal m_iconlist_sig; ///< notify if a window gets iconified/deiconified
     ScreenSignal m_clientlist_sig;  ///< client signal
+    FbTk::Timer m_clientlist_timer; ///< publishes deferred client list changes
+    std::set<const FluxboxWindow *> m_deferred_windows; ///< not published yet
     ScreenSignal m_bg_change_sig; ///< background change signal
     ScreenSignal m_workspacecount_sig; ///< workspace count signal
     ScreenSignal m_currentworkspace_sig; ///< current workspace signal
@@ -551,14 +578,43 @@ private:
         int y() const { return _y; }
         int width() const { return _width; }
         int height() const { return _height; }
+        bool operator ==(const XineramaHeadInfo &o) const {
+            return _x == o._x && _y == o._y &&
+                   _width == o._width && _height == o._height;
+        }
+        bool operator <(const XineramaHeadInfo &o) const {
+            if (_x != o._x) return _x < o._x;
+            if (_y != o._y) return _y < o._y;
+            if (_width != o._width) return _width < o._width;
+            return _height < o._height;
+        }
     };
+    typedef std::vector<XineramaHeadInfo> HeadLayout;
     struct {
         bool avail;
         int center_x;
         int center_y;
-        std::vector<XineramaHeadInfo> heads;
+        HeadLayout heads;
     } m_xinerama;
 
+    /// where a window was while a head layout was active
+    struct HeadLayoutPlace {
+        int head;
+        int x, y;
+        unsigned int width, height;
+    };
+    /// keyed by client window
+    typedef std::map<Window, HeadLayoutPlace> HeadLayoutPlaces;
+    struct SavedHeadLayout {
+        unsigned long saved; ///< value of m_head_layout_saves when saved
+        HeadLayoutPlaces places;
+    };
+    typedef std::map<HeadLayout, SavedHeadLayout> HeadLayouts;
+    HeadLayouts m_head_layouts;
+    unsigned long m_head_layout_saves; ///< counts saveHeadLayout() calls
+    /// remembers where the windows are in the current head layout
+    void saveHeadLayout();
+
     std::vector<HeadArea*> m_head_areas;
     std::vector<Strut*> m_head_struts;
 
@@ -203,6 +203,10 @@ private:
     Slit::Placement m_place;
 };
 
+// dockapps that restart unmap and map again in quick succession
+const uint64_t RECONFIGURE_DELAY = 50 * FbTk::FbTime::IN_MILLISECONDS;
+const uint64_t SAVE_DELAY = 2 * FbTk::FbTime::IN_SECONDS;
+
 } // End anonymous namespace
 
 unsigned int Slit::s_eventmask = SubstructureRedirectMask |  ButtonPressMask |
@@ -254,7 +258,7 @@ Slit::Slit(BScreen &scr, FbTk::Layer &layer, const char *filename)
     frame.window.setWindowRole("fluxbox-slit");
 
     // attach to theme and root window change signal
-    join(theme().reconfigSig(), FbTk::MemFun(*this, &Slit::reconfigure));
+    join(theme().reconfigSig(), FbTk::MemFun(*this, &Slit::themeReconfigured));
 
     join(scr.resizeSig(),
          FbTk::MemFun(*this, &Slit::screenSizeChanged));
@@ -275,6 +279,16 @@ Slit::Slit(BScreen &scr, FbTk::Layer &layer, const char *filename)
     FbTk::RefCount<FbTk::Command<void> > ucs(new FbTk::SimpleCommand<Slit>(*this, &Slit::updateCrossingState));
     m_timer.setCommand(ucs);
 
+    FbTk::RefCount<FbTk::Command<void> > reconf(new FbTk::SimpleCommand<Slit>(*this, &Slit::reconfigure));
+    m_reconfigure_timer.setTimeout(RECONFIGURE_DELAY);
+    m_reconfigure_timer.fireOnce(true);
+    m_reconfigure_timer.setCommand(reconf);
+
+    FbTk::RefCount<FbTk::Command<void> > save(new FbTk::SimpleCommand<Slit>(*this, &Slit::saveClientList));
+    m_save_timer.setTimeout(SAVE_DELAY);
+    m_save_timer.fireOnce(true);
+    m_save_timer.setCommand(save);
+
 
     FbTk::EventManager::instance()->add(*this, frame.window);
     FbTk::EventManager::instance()->addParent(*this, window());
@@ -489,13 +503,9 @@ void Slit::addClient(Window w) {
     FbTk::EventManager::instance()->add(*this, client->iconWindow());
 
     //    frame.window.show();
-    clearWindow();
-    reconfigure();
-
-    updateClientmenu();
-
-    saveClientList();
+    deferReconfigure();
 
+    m_save_timer.start();
 }
 
 void Slit::setPlacement(Placement place) {
@@ -562,12 +572,22 @@ void Slit::removeClient(Window w, bool remap) {
         }
     }
     if (reconf)
-        reconfigure();
+        deferReconfigure();
+
+}
 
+void Slit::deferReconfigure() {
+    if (!m_reconfigure_timer.isTiming())
+        m_reconfigure_timer.start();
 }
 
+void Slit::themeReconfigured() {
+    frame.pixmap_width = frame.pixmap_height = 0;
+    reconfigure();
+}
 
 void Slit::reconfigure() {
+    m_reconfigure_timer.stop();
 
     bool allow_autohide = true;
     if (m_hidden)
@@ -640,23 +660,29 @@ void Slit::reconfigure() {
     frame.window.setBorderWidth(theme()->borderWidth());
     frame.window.setBorderColor(theme()->borderColor());
 
-    Pixmap tmp = frame.pixmap;
-    FbTk::ImageControl &image_ctrl = screen().imageControl();
-    const FbTk::Texture &texture = m_slit_theme->texture();
-    if (!texture.usePixmap()) {
-        frame.pixmap = 0;
-        frame.window.setBackgroundColor(texture.color());
-    } else {
-        frame.pixmap = image_ctrl.renderImage(frame.width, frame.height,
-                                              texture);
-        if (frame.pixmap == 0)
+    // the texture only depends on the theme and our size
+    if (frame.pixmap_width != frame.width || frame.pixmap_height != frame.height) {
+        Pixmap tmp = frame.pixmap;
+        FbTk::ImageControl &image_ctrl = screen().imageControl();
+        const FbTk::Texture &texture = m_slit_theme->texture();
+        if (!texture.usePixmap()) {
+            frame.pixmap = 0;
             frame.window.setBackgroundColor(texture.color());
-        else
-            frame.window.setBackgroundPixmap(frame.pixmap);
-    }
+        } else {
+            frame.pixmap = image_ctrl.renderImage(frame.width, frame.height,
+                                                  texture);
+            if (frame.pixmap == 0)
+                frame.window.setBackgroundColor(texture.color());
+            else
+                frame.window.setBackgroundPixmap(frame.pixmap);
+        }
+
+        if (tmp)
+            image_ctrl.removeImage(tmp);
 
-    if (tmp)
-        image_ctrl.removeImage(tmp);
+        frame.pixmap_width = frame.width;
+        frame.pixmap_height = frame.height;
+    }
 
     // could have changed types, so we must set both
     if (FbTk::Transparent::haveComposite()) {
@@ -701,28 +727,35 @@ void Slit::reconfigure() {
         else
             y = (frame.height - (*client_it)->height()) / 2;
 
-        XMoveResizeWindow(disp, (*client_it)->window(), x, y,
-                          (*client_it)->width(), (*client_it)->height());
-
-        // for ICCCM compliance
-        (*client_it)->move(x, y);
-
-        XEvent event;
-        event.type = ConfigureNotify;
-
-        event.xconfigure.display = disp;
-        event.xconfigure.event = (*client_it)->window();
-        event.xconfigure.window = (*client_it)->window();
-        event.xconfigure.x = (*client_it)->x();
-        event.xconfigure.y = (*client_it)->y();
-        event.xconfigure.width = (*client_it)->width();
-        event.xconfigure.height = (*client_it)->height();
-        event.xconfigure.border_width = 0;
-        event.xconfigure.above = frame.window.window();
-        event.xconfigure.override_redirect = False;
-
-        XSendEvent(disp, (*client_it)->window(), False, StructureNotifyMask,
-                   &event);
+        // dockapps that keep their place are left alone, so one
+        // (re)mapping dockapp doesn't make all the others redraw
+        if (!(*client_it)->placed() ||
+            (*client_it)->x() != x || (*client_it)->y() != y) {
+
+            XMoveResizeWindow(disp, (*client_it)->window(), x, y,
+                              (*client_it)->width(), (*client_it)->height());
+
+            // for ICCCM compliance
+            (*client_it)->move(x, y);
+            (*client_it)->setPlaced(true);
+
+            XEvent event;
+            event.type = ConfigureNotify;
+
+            event.xconfigure.display = disp;
+            event.xconfigure.event = (*client_it)->window();
+            event.xconfigure.window = (*client_it)->window();
+            event.xconfigure.x = (*client_it)->x();
+            event.xconfigure.y = (*client_it)->y();
+            event.xconfigure.width = (*client_it)->width();
+            event.xconfigure.height = (*client_it)->height();
+            event.xconfigure.border_width = 0;
+            event.xconfigure.above = frame.window.window();
+            event.xconfigure.override_redirect = False;
+
+            XSendEvent(disp, (*client_it)->window(), False, StructureNotifyMask,
+                       &event);
+        }
 
         if (height_inc)
             y += (*client_it)->height() + bevel_width;
@@ -863,6 +896,7 @@ void Slit::reposition() {
 
 
 void Slit::shutdown() {
+    m_reconfigure_timer.stop();
     saveClientList();
     while (!m_client_list.empty())
         removeClient(m_client_list.front(), true, true);
@@ -1037,6 +1071,9 @@ void Slit::configureRequestEvent(XConfigureRequestEvent &event) {
     SlitClients::iterator it_end = m_client_list.end();
     for (; it != it_end; ++it) {
         if ((*it)->window() == event.window) {
+            // the dockapp placed itself, put it back on the next layout
+            if (event.value_mask & (CWX | CWY))
+                (*it)->setPlaced(false);
             if ((*it)->width() != ((unsigned) event.width) ||
                 (*it)->height() != ((unsigned) event.height)) {
                 (*it)->resize(event.width, event.height);
@@ -1049,7 +1086,7 @@ void Slit::configureRequestEvent(XConfigureRequestEvent &event) {
     }
 
     if (reconf)
-        reconfigure();
+        deferReconfigure();
 }
 
 void Slit::exposeEvent(XExposeEvent &ev) {
@@ -1159,6 +1196,7 @@ void Slit::updateClientmenu() {
 }
 
 void Slit::saveClientList() {
+    m_save_timer.stop();
 
     ofstream file(FbTk::StringUtil::expandFilename(m_filename).c_str());
     SlitClients::iterator it = m_client_list.begin();
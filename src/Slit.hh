@@ -134,6 +134,9 @@ private:
     void screenSizeChanged(BScreen &screen);
 
     void updateAlpha();
+    void themeReconfigured();
+    /// relayout once the current burst of dockapp changes is over
+    void deferReconfigure();
     void updateCrossingState();
     void clearWindow();
     void setupMenu();
@@ -150,6 +153,8 @@ private:
 
     BScreen &m_screen;
     FbTk::Timer m_timer;
+    FbTk::Timer m_reconfigure_timer; ///< coalesces dockapp (un)maps
+    FbTk::Timer m_save_timer; ///< writes the slitlist behind our back
 
     SlitClients m_client_list;
     std::unique_ptr<LayerMenu> m_layermenu;
@@ -161,7 +166,7 @@ private:
 
     struct frame {
         frame(const FbTk::FbWindow &parent):
-            pixmap(0),
+            pixmap(0), pixmap_width(0), pixmap_height(0),
             window(parent, 0, 0, 10, 10,
                    SubstructureRedirectMask |  ButtonPressMask |
                    EnterWindowMask | LeaveWindowMask | ExposureMask,
@@ -170,6 +175,8 @@ private:
         width(10), height(10) {  }
 
         Pixmap pixmap;
+        /// size the texture was rendered for, 0 after a theme change
+        unsigned int pixmap_width, pixmap_height;
         FbTk::FbWindow window;
         int x, y, x_hidden, y_hidden;
         unsigned int width, height;
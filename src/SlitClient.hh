@@ -46,13 +46,20 @@ public:
     unsigned int width() const { return m_width; }
     unsigned int height() const { return m_height; }
     bool visible() const { return m_visible; }
+    /// the window was configured to x(), y(), width(), height() by the slit
+    bool placed() const { return m_placed; }
 
 
     void setIconWindow(Window win) { m_icon_window = win; }
     void setWindow(Window win) { m_window = win; }
     void move(int x, int y) { m_x = x; m_y = y; }
-    void resize(unsigned int width, unsigned int height) { m_width = width; m_height = height; }
-    void moveResize(int x, int y, unsigned int width, unsigned int height) { m_x = x; m_y = y; m_width = width; m_height = height; }
+    void resize(unsigned int width, unsigned int height) {
+        if (width != m_width || height != m_height)
+            m_placed = false;
+        m_width = width; m_height = height;
+    }
+    void moveResize(int x, int y, unsigned int width, unsigned int height) { move(x, y); resize(width, height); }
+    void setPlaced(bool placed) { m_placed = placed; }
     void hide();
     void show();
     void setVisible(bool value) { m_visible = value; }
@@ -67,6 +74,7 @@ private:
     int m_x, m_y;
     unsigned int m_width, m_height;
     bool m_visible; ///< whether the client should be visible or not
+    bool m_placed;
 };
 
 #endif // SLITCLIENT_HH
@@ -299,7 +299,7 @@ FluxboxWindow::FluxboxWindow(WinClient &client):
     m_button_theme(*this, screen().focusedWinButtonTheme(),
                    screen().unfocusedWinButtonTheme()),
     m_theme(*this, screen().focusedWinFrameTheme(),
-            screen().unfocusedWinFrameTheme()),
+            screen().unfocusedWinFrameTheme(), false),
     m_frame(client.screen(), client.depth(), m_state, m_theme),
     m_placed(false),
     m_old_layernum(0),
@@ -307,6 +307,7 @@ FluxboxWindow::FluxboxWindow(WinClient &client):
     m_resize_corner(RIGHTBOTTOM) {
 
     join(m_theme.reconfigSig(), FbTk::MemFun(*this, &FluxboxWindow::themeReconfigured));
+    join(attentionSig(), FbTk::MemFunIgnoreArgs(*this, &FluxboxWindow::attentionChanged));
     join(m_frame.frameExtentSig(), FbTk::MemFun(*this, &FluxboxWindow::frameExtentChanged));
 
     init();
@@ -581,6 +582,9 @@ void FluxboxWindow::init() {
            twin->title().logical()<<endl;
     }
 
+    // popups are only announced once they stick around
+    if (isLightweight())
+        screen().deferClientList(*this);
     screen().getWorkspace(m_workspace_number)->addWindow(*this);
     if (m_placed)
         moveResize(frame().x(), frame().y(), real_width, real_height);
@@ -2042,8 +2046,10 @@ void FluxboxWindow::handleEvent(XEvent &event) {
             XFree(atomname);
 #endif // DEBUG
         WinClient *client = findClient(event.xproperty.window);
-        if (client)
+        if (client) {
             propertyNotifyEvent(*client, event.xproperty.atom);
+            propertySig().emit(*this);
+        }
 
     }
         break;
@@ -2926,8 +2932,38 @@ void FluxboxWindow::themeReconfigured() {
     sendConfigureNotify();
 }
 
+void FluxboxWindow::attentionChanged() {
+    // only the look changes, swap between the prerendered faces
+    frame().setFocus(isFocused() || getAttentionState());
+}
+
 void FluxboxWindow::workspaceAreaChanged(BScreen &screen) {
+    // leave the window alone if neither its head nor the window changed
+    // since the last time, usually only other heads did
+    std::vector<int> layout_area;
+    layoutArea(screen, layout_area);
+    if (layout_area == m_layout_area)
+        return;
+
     frame().applyState();
+    layoutArea(screen, m_layout_area);
+}
+
+void FluxboxWindow::layoutArea(BScreen &screen, std::vector<int> &area) const {
+    const int head = screen.getHead(fbWindow());
+    area.clear();
+    area.push_back(screen.getHeadX(head));
+    area.push_back(screen.getHeadY(head));
+    area.push_back(screen.getHeadWidth(head));
+    area.push_back(screen.getHeadHeight(head));
+    area.push_back(screen.maxLeft(head));
+    area.push_back(screen.maxTop(head));
+    area.push_back(screen.maxRight(head));
+    area.push_back(screen.maxBottom(head));
+    area.push_back(frame().x());
+    area.push_back(frame().y());
+    area.push_back(frame().width());
+    area.push_back(frame().height());
 }
 
 // commit current decoration values to actual displayed things
@@ -4044,6 +4080,12 @@ void FluxboxWindow::placeWindow(int head) {
     move(new_x, new_y);
 }
 
+bool FluxboxWindow::isLightweight() const {
+    return m_state.type == WindowState::TYPE_NOTIFICATION ||
+           m_state.type == WindowState::TYPE_UTILITY ||
+           Remember::instance().isRemembered(*m_client, Remember::REM_LIGHTWEIGHT);
+}
+
 void FluxboxWindow::setWindowType(WindowState::WindowType type) {
     m_state.type = type;
     switch (type) {
@@ -4111,15 +4153,32 @@ void FluxboxWindow::setWindowType(WindowState::WindowType type) {
         setIconHidden(true);
         moveToLayer(::ResourceLayer::ABOVE_DOCK);
         break;
+    case WindowState::TYPE_NOTIFICATION:
+        /*
+         * _NET_WM_WINDOW_TYPE_NOTIFICATION and _NET_WM_WINDOW_TYPE_TOOLTIP
+         * are popups that show up on their own and are gone a few
+         * seconds later. Like splash screens they get no decoration
+         * and no focus, and they stay above normal windows.
+         */
+        setDecorationMask(WindowState::DECOR_NONE);
+        setFocusHidden(true);
+        setIconHidden(true);
+        setFocusNew(false);
+        setMouseFocus(false);
+        setClickFocus(false);
+        setTabable(false);
+        moveToLayer(::ResourceLayer::ABOVE_DOCK);
+        break;
+    case WindowState::TYPE_UTILITY:
+        /*
+         * _NET_WM_WINDOW_TYPE_UTILITY is a small persistent window, like
+         * a palette or toolbox. It is managed like a normal window, but
+         * is published lazily (see isLightweight).
+         */
     case WindowState::TYPE_NORMAL:
     default:
         break;
     }
-
-    /*
-     * NOT YET IMPLEMENTED:
-     *   _NET_WM_WINDOW_TYPE_UTILITY
-     */
 }
 
 void FluxboxWindow::focusedWindowChanged(BScreen &screen,
@@ -37,6 +37,7 @@
 #include "FbTk/EventHandler.hh"
 #include "FbTk/LayerItem.hh"
 #include "FbTk/Signal.hh"
+#include "FbTk/MemoryPool.hh"
 
 #include <vector>
 #include <string>
@@ -71,6 +72,7 @@ namespace Focus {
 /// Creates the window frame and handles any window event for it
 class FluxboxWindow: public Focusable,
                      public FbTk::EventHandler,
+                     public FbTk::PoolAllocated,
                      private FbTk::SignalTracker {
 public:
     /// Motif wm Hints
@@ -387,6 +389,12 @@ public:
 
     bool isFocusHidden() const { return m_state.focus_hidden; }
     bool isIconHidden() const { return m_state.icon_hidden; }
+    /**
+     * Popups and tool windows (notifications, tooltips, utility windows
+     * and whatever has [Lightweight] {yes} in the apps file) are
+     * published to pagers and menus lazily.
+     */
+    bool isLightweight() const;
     bool isManaged() const { return m_initialized; }
     bool isVisible() const;
     bool isIconic() const { return m_state.iconic; }
@@ -479,6 +487,8 @@ public:
     FbTk::Signal<FluxboxWindow &> &stateSig() { return m_statesig; }
     FbTk::Signal<FluxboxWindow &> &layerSig() { return m_layersig; }
     FbTk::Signal<FluxboxWindow &> &hintSig() { return m_hintsig; }
+    /// emitted after a property of one of the clients changed
+    FbTk::Signal<FluxboxWindow &> &propertySig() { return m_propertysig; }
     FbTk::Signal<FluxboxWindow &> &workspaceSig() { return m_workspacesig; }
     /** @} */ // end group signals
 
@@ -498,6 +508,8 @@ private:
     void grabButtons();
 
     void themeReconfigured();
+    /// flashes the frame without touching its geometry
+    void attentionChanged();
 
     /**
      * Calculates insertition position in the list by
@@ -544,11 +556,14 @@ private:
     void focusedWindowChanged(BScreen &screen, FluxboxWindow *focused_win, WinClient* client);
     /// Called when workspace area on screen changed.
     void workspaceAreaChanged(BScreen &screen);
+    /// what the maximized layout of the window depends on
+    void layoutArea(BScreen &screen, std::vector<int> &area) const;
     void frameExtentChanged();
 
 
     // state and hint signals
-    FbTk::Signal<FluxboxWindow &> m_workspacesig, m_statesig, m_layersig, m_hintsig;
+    FbTk::Signal<FluxboxWindow &> m_workspacesig, m_statesig, m_layersig, m_hintsig,
+        m_propertysig;
 
     uint64_t m_creation_time;
     uint64_t m_last_keypress_time;
@@ -613,6 +628,7 @@ private:
     FbWinFrame m_frame;  ///< the actual window frame
 
     bool m_placed; ///< determine whether or not we should place the window
+    std::vector<int> m_layout_area; ///< layoutArea() after the last workspaceAreaChanged()
 
     int m_old_layernum;
 
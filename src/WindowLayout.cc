@@ -0,0 +1,379 @@
+// WindowLayout.cc for Fluxbox Window Manager
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "WindowLayout.hh"
+
+#ifdef HAVE_CMATH
+  #include <cmath>
+#else
+  #include <math.h>
+#endif
+#include <algorithm>
+#include <set>
+
+namespace WindowLayout {
+
+void arrange(TileMethod method, const Box &head,
+             const std::vector<Frame> &frames,
+             std::vector<Geometry> &result) {
+
+    result.clear();
+
+    std::vector<size_t> normal_frames;
+    std::vector<size_t> shaded_frames;
+    const Frame *main_frame = 0; // Main (big) window for stacked modes
+    size_t main_index = 0;
+
+    for (size_t i = 0; i < frames.size(); ++i) {
+        if (method >= STACKLEFT && frames[i].focused) {
+            main_frame = &frames[i];
+            main_index = i;
+        } else if (frames[i].shaded)
+            shaded_frames.push_back(i);
+        else
+            normal_frames.push_back(i);
+    }
+
+    // if using stacked-left/right/top/bottom and we don't have a main window yet
+    // (no focused window?), we'll fall back on using the last window in the
+    // window list.
+    if (main_frame == 0 && method >= STACKLEFT && !normal_frames.empty()) {
+        main_index = normal_frames.back();
+        main_frame = &frames[main_index];
+        normal_frames.pop_back();
+    }
+
+    // to arrange only shaded windows is a bit pointless imho (mathias)
+    size_t win_count = normal_frames.size();
+    if (win_count == 0) {
+        if (!main_frame)
+            return;
+        win_count = 1;
+    }
+
+    result.resize(frames.size());
+
+    int x_offs = head.left; // window position offset in x
+    int y_offs = head.top; // window position offset in y
+    unsigned int max_width = head.right - head.left;
+    unsigned int max_height = head.bottom - head.top;
+
+    if (method == STACKLEFT || method == STACKRIGHT)
+        max_width = max_width / 2;
+
+    if (method == STACKTOP || method == STACKBOTTOM)
+        max_height = max_height / 2;
+
+    // try to get the same number of rows as columns.
+    unsigned int cols = int(sqrt((float)win_count));  // truncate to lower
+    unsigned int rows = int(0.99 + float(win_count) / float(cols));
+    if (method == VERTICAL ||  // rotate if the user has asked for it or automagically
+        (method == UNSPECIFIED && max_width < max_height)) {
+        std::swap(cols, rows);
+    }
+
+    // Stacked mode only uses half the screen for tiled windows, so adjust
+    // offset to half the screen (horizontal or vertical depending on
+    // stacking mode)
+    if (method == STACKRIGHT)
+        x_offs += static_cast<int>(max_width);
+    else if (method == STACKBOTTOM)
+        y_offs += static_cast<int>(max_height);
+
+    const int orig_x_offs = x_offs;
+    const int orig_y_offs = y_offs;
+
+    // place the shaded windows
+    // TODO: place them in the same columns as the normal windows, for now
+    // they are stacked unchanged ontop of the current head
+    for (size_t i = 0; i < shaded_frames.size(); ++i) {
+        const Frame &frame = frames[shaded_frames[i]];
+        Geometry &geom = result[shaded_frames[i]];
+        geom.x = (i & 1) ? x_offs : head.right - static_cast<int>(frame.width);
+        geom.y = y_offs;
+        geom.width = frame.width;
+        geom.height = frame.height;
+        geom.resize = false;
+
+        y_offs += frame.height;
+    }
+
+    // TODO: what if the number of shaded windows is really big and we end up
+    // with really little space left for the normal windows? how to handle
+    // this?
+    if (!shaded_frames.empty())
+        max_height -= shaded_frames.size() * frames[shaded_frames.front()].height;
+
+    const unsigned int cal_width = max_width/cols; // width ratio (width of every window)
+    const unsigned int cal_height = max_height/rows; // height ratio (height of every window)
+
+    // Resizes and sets windows positions in columns and rows.
+    for (unsigned int i = 0; i < rows; ++i) {
+        x_offs = orig_x_offs;
+        for (unsigned int j = 0; j < cols && !normal_frames.empty(); ++j) {
+
+            int cell_center_x = x_offs + (x_offs + cal_width) / 2;
+            int cell_center_y = y_offs + (y_offs + cal_height) / 2;
+            unsigned int closest_dist = ~0;
+
+            std::vector<size_t>::iterator closest = normal_frames.begin();
+            std::vector<size_t>::iterator it = normal_frames.begin();
+            for (; it != normal_frames.end(); ++it) {
+                const Frame &frame = frames[*it];
+                int win_center_x = frame.x + (frame.x + frame.width / 2);
+                int win_center_y = frame.y + (frame.y + frame.height / 2);
+                unsigned int dist = (win_center_x - cell_center_x) * (win_center_x - cell_center_x) +
+                                    (win_center_y - cell_center_y) * (win_center_y - cell_center_y);
+
+                if (dist < closest_dist) {
+                    closest = it;
+                    closest_dist = dist;
+                }
+            }
+
+            const Frame &frame = frames[*closest];
+            Geometry &geom = result[*closest];
+            geom.x = x_offs + frame.x_offset;
+            geom.y = y_offs + frame.y_offset;
+            geom.width = cal_width - frame.width_offset;
+            geom.height = cal_height - frame.height_offset;
+            geom.resize = true;
+
+            // the last window gets everything that is left.
+            if (normal_frames.size() == 1) {
+                geom.width = head.right - x_offs - frame.width_offset;
+                geom.height = static_cast<int>(cal_height) - frame.height_offset;
+
+                if (method == STACKLEFT)
+                    geom.width -= max_width;
+            }
+
+            normal_frames.erase(closest);
+
+            x_offs += static_cast<int>(cal_width);
+        }
+
+        y_offs += static_cast<int>(cal_height);
+    }
+
+    // If using a stacked mechanism we now need to place the main window.
+    if (main_frame != 0) {
+        Geometry &geom = result[main_index];
+        geom.x = head.left;
+        geom.y = head.top;
+        geom.width = max_width;
+        geom.height = max_height;
+        geom.resize = true;
+        if (method == STACKLEFT) {
+            geom.x += max_width;
+            geom.y = orig_y_offs;
+        } else if (method == STACKTOP)
+            geom.y = max_height;
+    }
+}
+
+namespace {
+
+class Area {
+public:
+
+    enum Corner {
+        TOPLEFT,
+        TOPRIGHT,
+        BOTTOMLEFT,
+        BOTTOMRIGHT
+    } corner; // indicates the corner of the window that will be placed
+
+    Area(Corner _corner, int _x, int _y):
+        corner(_corner), x(_x), y(_y) { };
+
+    // position where the top left corner of the window will be placed
+    int x, y;
+};
+
+class AreaLess {
+public:
+    explicit AreaLess(const Order &order): m_order(order) { }
+
+    bool operator ()(const Area &a, const Area &o) const {
+        if (m_order.columns) {
+            // if we're making columns, x-value is most important
+            if (a.x != o.x)
+                return ((a.x < o.x) ^ m_order.right_to_left);
+            if (a.y != o.y)
+                return ((a.y < o.y) ^ m_order.bottom_to_top);
+        } else {
+            // if we're making rows, y-value is most important
+            if (a.y != o.y)
+                return ((a.y < o.y) ^ m_order.bottom_to_top);
+            if (a.x != o.x)
+                return ((a.x < o.x) ^ m_order.right_to_left);
+        }
+        return (a.corner < o.corner);
+    }
+
+private:
+    Order m_order;
+};
+
+} // end anonymous namespace
+
+void minOverlap(const Box &head, int win_w, int win_h, int layer,
+                const std::vector<Window> &windows, const Order &order,
+                int &place_left, int &place_top) {
+
+    // we keep a set of open spaces on the desktop, sorted by size/location
+    typedef std::set<Area, AreaLess> Areas;
+    Areas areas = Areas(AreaLess(order));
+
+    // initialize the set of areas to contain the entire head
+    areas.insert(Area(Area::TOPLEFT, head.left, head.top));
+    areas.insert(Area(Area::TOPRIGHT, head.right - win_w, head.top));
+    areas.insert(Area(Area::BOTTOMLEFT, head.left, head.bottom - win_h));
+    areas.insert(Area(Area::BOTTOMRIGHT, head.right - win_w, head.bottom - win_h));
+
+    // go through the list of windows, creating other reasonable placements
+    // at the end, we'll find the one with minimum overlap
+    // the size of this set is at most 2(n+2)(n+1) (n = number of windows)
+    // finding overlaps is therefore O(n^3), but it can probably be improved
+    int nr_windows = 0;
+    std::vector<Window>::const_iterator it = windows.begin(),
+                                        it_end = windows.end();
+    for (; it != it_end; ++it) {
+        if (!it->placed)
+            continue;
+        ++nr_windows;
+        if (it->layer != layer)
+            continue; //windows are in different layers - skip it
+
+        const Box &box = it->box;
+
+        // go through the list of regions
+        // if this window overlaps that region and the new window still fits,
+        // it will create new regions to test
+        Areas::iterator ar_it = areas.begin();
+        for (; ar_it != areas.end(); ++ar_it) {
+
+            switch (ar_it->corner) {
+                case Area::TOPLEFT:
+                    if (box.right > ar_it->x && box.bottom > ar_it->y) {
+                        if (box.bottom + win_h <= head.bottom)
+                            areas.insert(Area(Area::TOPLEFT, ar_it->x, box.bottom));
+                        if (box.right + win_w <= head.right)
+                            areas.insert(Area(Area::TOPLEFT, box.right, ar_it->y));
+                    }
+                    break;
+                case Area::TOPRIGHT:
+                    if (box.left < ar_it->x + win_w && box.bottom > ar_it->y) {
+                        if (box.bottom + win_h <= head.bottom)
+                            areas.insert(Area(Area::TOPRIGHT, ar_it->x, box.bottom));
+                        if (box.left - win_w >= head.left)
+                            areas.insert(Area(Area::TOPRIGHT, box.left - win_w, ar_it->y));
+                    }
+                    break;
+                case Area::BOTTOMRIGHT:
+                    if (box.left < ar_it->x + win_w && box.top < ar_it->y + win_h) {
+                        if (box.top - win_h >= head.top)
+                            areas.insert(Area(Area::BOTTOMRIGHT, ar_it->x, box.top - win_h));
+                        if (box.left - win_w >= head.left)
+                            areas.insert(Area(Area::BOTTOMRIGHT, box.left - win_w, ar_it->y));
+                    }
+                    break;
+                case Area::BOTTOMLEFT:
+                    if (box.right > ar_it->x && box.top < ar_it->y + win_h) {
+                        if (box.top - win_h >= head.top)
+                            areas.insert(Area(Area::BOTTOMLEFT, ar_it->x, box.top - win_h));
+                        if (box.right + win_w <= head.right)
+                            areas.insert(Area(Area::BOTTOMLEFT, box.right, ar_it->y));
+                    }
+                    break;
+            }
+
+        }
+    }
+
+    // choose the region with minimum overlap
+    int min_so_far = win_w * win_h * nr_windows + 1;
+    Areas::iterator min_reg = areas.begin();
+
+    Areas::iterator ar_it = areas.begin();
+    for (; ar_it != areas.end(); ++ar_it) {
+
+        int overlap = 0;
+        for (it = windows.begin(); it != it_end; ++it) {
+            if (!it->placed)
+                continue;
+
+            const Box &box = it->box;
+
+            // get the coordinates of the overlap region
+            int min_right = std::min(box.right, ar_it->x + win_w);
+            int min_bottom = std::min(box.bottom, ar_it->y + win_h);
+            int max_left = std::max(box.left, ar_it->x);
+            int max_top = std::max(box.top, ar_it->y);
+
+            // now compute the overlap and add to running total
+            if (min_right > max_left && min_bottom > max_top)
+                overlap += (min_right - max_left) * (min_bottom - max_top);
+
+        }
+
+        // if this placement is better, use it
+        if (overlap < min_so_far) {
+            min_reg = ar_it;
+            min_so_far = overlap;
+            if (overlap == 0) // can't do better than this
+                break;
+        }
+
+    }
+
+    place_left = min_reg->x;
+    place_top = min_reg->y;
+}
+
+void unclutter(const Box &head, const Order &order,
+               const std::vector<size_t> &indices,
+               std::vector<Window> &windows) {
+
+    // take them all off the workspace first
+    for (size_t i = 0; i < indices.size(); ++i)
+        windows[indices[i]].placed = false;
+
+    for (size_t i = 0; i < indices.size(); ++i) {
+        Window &win = windows[indices[i]];
+        const int width = win.box.right - win.box.left;
+        const int height = win.box.bottom - win.box.top;
+
+        int left, top;
+        minOverlap(head, win.normal_width, win.normal_height, win.layer,
+                   windows, order, left, top);
+
+        win.box.left = left;
+        win.box.top = top;
+        win.box.right = left + width;
+        win.box.bottom = top + height;
+        win.placed = true;
+    }
+}
+
+} // end namespace WindowLayout
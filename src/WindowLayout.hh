@@ -0,0 +1,116 @@
+// WindowLayout.hh for Fluxbox Window Manager
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#ifndef WINDOWLAYOUT_HH
+#define WINDOWLAYOUT_HH
+
+#include <vector>
+#include <cstddef>
+
+/**
+   Layouts for commands that rearrange a whole workspace at once.
+
+   They work on a plain model of the windows and only compute the new
+   geometries, so the commands can apply all of them in one pass and the
+   algorithms can be tested without an X server (see
+   tests/testWindowLayout.cc).
+ */
+namespace WindowLayout {
+
+struct Box {
+    int left, top, right, bottom;
+};
+
+/// what ArrangeWindowsCmd sees of a window
+struct Frame {
+    int x, y;
+    unsigned int width, height;
+    int x_offset, y_offset;
+    int width_offset, height_offset;
+    bool shaded;
+    bool focused;
+};
+
+/// new geometry of a Frame, only the position of shaded windows changes
+struct Geometry {
+    int x, y;
+    unsigned int width, height;
+    bool resize;
+};
+
+/// same order as ArrangeWindowsCmd's methods
+enum TileMethod {
+    UNSPECIFIED,
+    VERTICAL,
+    HORIZONTAL,
+    STACKLEFT,
+    STACKRIGHT,
+    STACKTOP,
+    STACKBOTTOM
+};
+
+/**
+   Tiles frames into rows and columns on head, shaded frames are stacked
+   on top. With the stacking methods the focused frame (or the last one)
+   gets half of the head.
+   @param result geometry for each frame, empty if there is nothing to do
+ */
+void arrange(TileMethod method, const Box &head,
+             const std::vector<Frame> &frames,
+             std::vector<Geometry> &result);
+
+
+/// what MinOverlapPlacement sees of a window
+struct Window {
+    Box box; ///< outer extents, including border and decorations
+    unsigned int normal_width, normal_height; ///< outer size when placed
+    int layer;
+    bool placed; ///< windows without a place yet are ignored
+};
+
+/// in which order free spots are tried
+struct Order {
+    bool columns;
+    bool right_to_left;
+    bool bottom_to_top;
+};
+
+/**
+   Finds the spot for the top left corner of a width x height window on
+   layer with the least overlap with windows. Corners of windows on the
+   same layer are tried in order, the first spot without overlap wins.
+ */
+void minOverlap(const Box &head, int width, int height, int layer,
+                const std::vector<Window> &windows, const Order &order,
+                int &left, int &top);
+
+/**
+   Places the windows with the given indices one after another, each
+   avoiding the ones placed before it. Their boxes are updated.
+ */
+void unclutter(const Box &head, const Order &order,
+               const std::vector<size_t> &indices,
+               std::vector<Window> &windows);
+
+} // end namespace WindowLayout
+
+#endif // WINDOWLAYOUT_HH
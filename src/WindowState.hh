@@ -103,7 +103,9 @@ public:
         TYPE_SPLASH,
         TYPE_DIALOG,
         TYPE_MENU,
-        TYPE_TOOLBAR
+        TYPE_TOOLBAR,
+        TYPE_UTILITY,
+        TYPE_NOTIFICATION ///< also tooltips
     };
 
     WindowState():
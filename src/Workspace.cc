@@ -57,6 +57,7 @@ using std::string;
 Workspace::Workspace(BScreen &scrn, const string &name, unsigned int id):
     m_screen(scrn),
     m_clientmenu(scrn, m_windowlist, false),
+    m_clientmenu_dirty(false),
     m_name(name),
     m_id(id) {
 
@@ -81,7 +82,10 @@ void Workspace::addWindow(FluxboxWindow &w) {
     w.setWorkspace(m_id);
 
     m_windowlist.push_back(&w);
-    m_clientlist_sig.emit();
+    if (m_screen.isDeferred(w))
+        m_clientmenu_dirty = true;
+    else
+        updateClientmenu();
 
 }
 
@@ -103,7 +107,11 @@ int Workspace::removeWindow(FluxboxWindow *w, bool still_alive) {
         FocusControl::unfocusWindow(w->winClient(), true, true);
 
     m_windowlist.remove(w);
-    m_clientlist_sig.emit();
+    // a popup that never made it into the menu doesn't need a refresh
+    if (m_screen.isDeferred(*w))
+        m_clientmenu_dirty = true;
+    else
+        updateClientmenu();
 
     return m_windowlist.size();
 }
@@ -185,5 +193,11 @@ void Workspace::shutdown() {
 }
 
 void Workspace::updateClientmenu() {
+    m_clientmenu_dirty = false;
     m_clientlist_sig.emit();
 }
+
+void Workspace::flushClientmenu() {
+    if (m_clientmenu_dirty)
+        updateClientmenu();
+}
@@ -61,6 +61,8 @@ public:
     void addWindow(FluxboxWindow &win);
     int removeWindow(FluxboxWindow *win, bool still_alive);
     void updateClientmenu();
+    /// refresh the client menu if a lightweight window left it behind
+    void flushClientmenu();
 
     BScreen &screen() { return m_screen; }
     const BScreen &screen() const { return m_screen; }
@@ -87,6 +89,7 @@ private:
     Windows m_windowlist;
     FbTk::Signal<> m_clientlist_sig;
     ClientMenu m_clientmenu;
+    bool m_clientmenu_dirty; ///< waits for BScreen to publish the client list
 
     FbTk::FbString m_name;  ///< name of this workspace
     unsigned int m_id;    ///< id, obsolete, this should be in BScreen
@@ -33,6 +33,7 @@
 #include "WinClient.hh"
 #include "FocusControl.hh"
 #include "WindowCmd.hh"
+#include "WindowLayout.hh"
 
 #include "FbTk/KeyUtil.hh"
 #include "FbTk/CommandParser.hh"
@@ -41,11 +42,6 @@
 
 #include "Debug.hh"
 
-#ifdef HAVE_CMATH
-  #include <cmath>
-#else
-  #include <math.h>
-#endif
 #include <algorithm>
 #include <functional>
 #include <vector>
@@ -417,180 +413,43 @@ void ArrangeWindowsCmd::execute() {
     //        -  only on current head
     const int head = screen->getCurrHead();
     Workspace::Windows::iterator win;
-    Workspace::Windows normal_windows;
-    Workspace::Windows shaded_windows;
-    FluxboxWindow* main_window = NULL; // Main (big) window for stacked modes
+    std::vector<FluxboxWindow *> windows;
+    std::vector<WindowLayout::Frame> frames;
 
     for (win = space->windowList().begin(); win != space->windowList().end(); ++win) {
         int winhead = screen->getHead((*win)->fbWindow());
         if ((winhead == head || winhead == 0) && m_pat.match(**win)) {
-
-            if ((m_tile_method >= STACKLEFT) && (*win)->isFocused()) {
-                main_window = (*win);
-            } else {
-                if ((*win)->isShaded())
-                    shaded_windows.push_back(*win);
-                else
-                    normal_windows.push_back(*win);
-            }
-        }
-    }
-
-    // if using stacked-left/right/top/bottom and we don't have a main window yet
-    // (no focused window?), we'll fall back on using the last window in the
-    // window list.
-    if (main_window == NULL && (m_tile_method >= STACKLEFT)) {
-        main_window = normal_windows.back();
-        normal_windows.pop_back();
-    }
-
-    // to arrange only shaded windows is a bit pointless imho (mathias)
-    size_t win_count = normal_windows.size();
-    if (win_count == 0) {
-        if (!main_window) {
-            return;
+            WindowLayout::Frame frame;
+            frame.x = (*win)->frame().x();
+            frame.y = (*win)->frame().y();
+            frame.width = (*win)->frame().width();
+            frame.height = (*win)->frame().height();
+            frame.x_offset = (*win)->xOffset();
+            frame.y_offset = (*win)->yOffset();
+            frame.width_offset = (*win)->widthOffset();
+            frame.height_offset = (*win)->heightOffset();
+            frame.shaded = (*win)->isShaded();
+            frame.focused = (*win)->isFocused();
+            frames.push_back(frame);
+            windows.push_back(*win);
         }
-        win_count = 1;
-    }
-
-
-    int x_offs = screen->maxLeft(head); // window position offset in x
-    int y_offs = screen->maxTop(head); // window position offset in y
-    unsigned int max_width = screen->maxRight(head) - screen->maxLeft(head);
-    unsigned int max_height = screen->maxBottom(head) - screen->maxTop(head);
-
-    if ((m_tile_method == STACKLEFT) || (m_tile_method == STACKRIGHT)) {
-        max_width = max_width / 2;
-    }
-
-    if ((m_tile_method == STACKTOP) || (m_tile_method == STACKBOTTOM)) {
-        max_height = max_height / 2;
     }
 
-    // try to get the same number of rows as columns.
-    unsigned int cols = int(sqrt((float)win_count));  // truncate to lower
-    unsigned int rows = int(0.99 + float(win_count) / float(cols));
-    if (  (m_tile_method == VERTICAL) ||  // rotate if the user has asked for it or automagically
-          ( (m_tile_method == UNSPECIFIED) && (max_width<max_height)) ) {
-        std::swap(cols, rows);
-    }
-
-    // Stacked mode only uses half the screen for tiled windows, so adjust
-    // offset to half the screen (horizontal or vertical depending on 
-    // stacking mode)
-    switch (m_tile_method) {
-    case STACKRIGHT:
-        x_offs += static_cast<int>(max_width);
-        break;
-    case STACKBOTTOM:
-        y_offs += static_cast<int>(max_height);
-        break;
-    default:
-        // no change needed for STACKLEFT/STACKTOP
-        break;
-    }
+    std::vector<WindowLayout::Geometry> result;
+    WindowLayout::arrange(static_cast<WindowLayout::TileMethod>(m_tile_method),
+                          MinOverlapPlacement::headBox(*screen, head),
+                          frames, result);
 
-    // Since the placing algorithm loop below modifies the offsets, but we
-    // still need them to position the main window, we save the calculated
-    // values.
-    const int orig_x_offs = x_offs;
-    const int orig_y_offs = y_offs;
-
-    unsigned int i;
-    unsigned int j;
-
-    // place the shaded windows
-    // TODO: until i resolve the shadedwindow->moveResize() issue to place
-    // them in the same columns as the normal windows i just place the shaded
-    // windows unchanged ontop of the current head
-    for (i = 0, win = shaded_windows.begin(); win != shaded_windows.end(); ++win, ++i) {
-        if (i & 1)
-            (*win)->move(x_offs, y_offs);
+    // apply the whole layout at once
+    XGrabServer(Fluxbox::instance()->display());
+    for (size_t i = 0; i < result.size(); ++i) {
+        const WindowLayout::Geometry &geom = result[i];
+        if (geom.resize)
+            windows[i]->moveResize(geom.x, geom.y, geom.width, geom.height);
         else
-            (*win)->move(screen->maxRight(head) - (*win)->frame().width(), y_offs);
-
-        y_offs += (*win)->frame().height();
-    }
-
-    // TODO: what if the number of shaded windows is really big and we end up
-    // with really little space left for the normal windows? how to handle
-    // this?
-    if (!shaded_windows.empty())
-        max_height -= i * (*shaded_windows.begin())->frame().height();
-
-    const unsigned int cal_width = max_width/cols; // width ratio (width of every window)
-    const unsigned int cal_height = max_height/rows; // height ratio (height of every window)
-
-    // Resizes and sets windows positions in columns and rows.
-    for (i = 0; i < rows; ++i) {
-        x_offs = orig_x_offs;
-        for (j = 0; j < cols && !normal_windows.empty(); ++j) {
-
-
-            int cell_center_x = x_offs + (x_offs + cal_width) / 2;
-            int cell_center_y = y_offs + (y_offs + cal_height) / 2;
-            unsigned int closest_dist = ~0;
-
-            Workspace::Windows::iterator closest = normal_windows.end();
-            for (win = normal_windows.begin(); win != normal_windows.end(); ++win) {
-
-                int win_center_x = (*win)->frame().x() + ((*win)->frame().x() + (*win)->frame().width() / 2);
-                int win_center_y = (*win)->frame().y() + ((*win)->frame().y() + (*win)->frame().height() / 2);
-                unsigned int dist = (win_center_x - cell_center_x) * (win_center_x - cell_center_x) +
-                                    (win_center_y - cell_center_y) * (win_center_y - cell_center_y);
-
-                if (dist < closest_dist) {
-                    closest = win;
-                    closest_dist = dist;
-                }
-            }
-
-            int x = x_offs + (*closest)->xOffset();
-            int y = y_offs + (*closest)->yOffset();
-            unsigned int w = cal_width - (*closest)->widthOffset();
-            unsigned int h = cal_height - (*closest)->heightOffset();
-
-            // the last window gets everything that is left.
-            if (normal_windows.size() == 1) {
-
-                w = static_cast<int>(screen->maxRight(head)) - x_offs - (*closest)->widthOffset();
-                h = static_cast<int>(cal_height) - (*closest)->heightOffset();
-
-                if (m_tile_method == STACKLEFT) {
-                    w -= max_width;
-                }
-            }
-
-            (*closest)->moveResize(x, y, w, h);
-            normal_windows.erase(closest);
-
-            x_offs += static_cast<int>(cal_width);
-        }
-
-        y_offs += static_cast<int>(cal_height);
-    }
-
-    // If using a stacked mechanism we now need to place the main window.
-    if (main_window != NULL){
-        x_offs = screen->maxLeft(head);
-        switch (m_tile_method){
-            case STACKLEFT:
-                main_window->moveResize(x_offs + max_width, orig_y_offs, max_width, max_height);
-                break;
-            case STACKRIGHT:
-                main_window->moveResize(x_offs, screen->maxTop(head), max_width, max_height);
-                break;
-            case STACKTOP:
-                main_window->moveResize(x_offs, max_height, max_width, max_height);
-                break;
-            case STACKBOTTOM:
-                main_window->moveResize(x_offs, screen->maxTop(head), max_width, max_height);
-                break;
-            default:
-                // Shouldn't happen.
-                break;
-        }
+            windows[i]->move(geom.x, geom.y);
     }
+    XUngrabServer(Fluxbox::instance()->display());
 }
 
 void UnclutterCmd::execute() {
@@ -603,29 +462,40 @@ void UnclutterCmd::execute() {
     if (space->windowList().empty())
         return;
 
+    std::vector<FluxboxWindow *> windows;
+    std::vector<WindowLayout::Window> model;
+    MinOverlapPlacement::workspaceModel(*screen, screen->currentWorkspaceID(),
+                                        windows, model);
+
     const int head = screen->getCurrHead();
     Workspace::Windows::iterator win;
-    Workspace::Windows placed_windows;
+    std::vector<size_t> placed_windows;
 
-    // list and clean up
     for (win = space->windowList().begin(); win != space->windowList().end(); ++win) {
         int winhead = screen->getHead((*win)->fbWindow());
         if ((winhead == head || winhead == 0) && m_pat.match(**win)) {
-            placed_windows.push_back(*win);
-            (*win)->move(-(*win)->width(), -(*win)->height());
+            std::vector<FluxboxWindow *>::iterator it =
+                std::find(windows.begin(), windows.end(), *win);
+            if (it != windows.end())
+                placed_windows.push_back(it - windows.begin());
         }
     }
 
     if (placed_windows.empty())
         return;
 
-    // place
-    MinOverlapPlacement mopp;
-    int x, y;
-    for (win = placed_windows.begin(); win != placed_windows.end(); ++win) {
-        mopp.placeWindow(**win, head, x, y);
-        (*win)->move(x, y);
+    WindowLayout::unclutter(MinOverlapPlacement::headBox(*screen, head),
+                            MinOverlapPlacement::order(*screen),
+                            placed_windows, model);
+
+    // apply the whole layout at once
+    XGrabServer(Fluxbox::instance()->display());
+    for (size_t i = 0; i < placed_windows.size(); ++i) {
+        FluxboxWindow *fbwin = windows[placed_windows[i]];
+        const WindowLayout::Box &box = model[placed_windows[i]].box;
+        fbwin->move(box.left + fbwin->xOffset(), box.top + fbwin->yOffset());
     }
+    XUngrabServer(Fluxbox::instance()->display());
 }
 
 REGISTER_COMMAND(showdesktop, ShowDesktopCmd, void);
@@ -170,6 +170,7 @@ private:
 /// arranges windows in current workspace to rows and columns
 class ArrangeWindowsCmd: public FbTk::Command<void> {
 public:
+    /// same order as WindowLayout::TileMethod
     enum {
       UNSPECIFIED,
       VERTICAL,
@@ -52,11 +52,10 @@
 #include "FbTk/RefCount.hh"
 #include "FbTk/CompareEqual.hh"
 #include "FbTk/Transparent.hh"
-#include "FbTk/Select2nd.hh"
-#include "FbTk/Compose.hh"
 #include "FbTk/KeyUtil.hh"
 #include "FbTk/MemFun.hh"
 #include "FbTk/MenuItem.hh"
+#include "FbTk/MemoryPool.hh"
 
 #ifdef USE_EWMH
 #include "Ewmh.hh"
@@ -120,7 +119,6 @@ using std::vector;
 using std::list;
 using std::pair;
 using std::mem_fn;
-using std::equal_to;
 using std::hex;
 using std::dec;
 
@@ -233,6 +231,17 @@ bool s_have_shape = false ; ///< if shape is supported by server
 
 Fluxbox* s_singleton = 0;
 
+#ifdef DEBUG
+/// what closing a client gave back to the pool, see BScreen::createWindow
+void logPoolRelease(const char *event, Window client,
+                    const FbTk::MemoryPool::Stats &before) {
+    const FbTk::MemoryPool::Stats &after = FbTk::MemoryPool::stats();
+    fbdbg<<event<<"("<<hex<<client<<dec<<"): "
+         <<(long(before.in_use) - long(after.in_use))<<" blocks returned, "
+         <<after.in_use<<" blocks in use"<<endl;
+}
+#endif // DEBUG
+
 } // end anonymous
 
 
@@ -322,6 +331,18 @@ Fluxbox::Fluxbox(int argc, char **argv,
     m_key_reload_timer.setCommand(FbTk::RefCount<FbTk::Command<void> >(rh_cmd));
     m_key_reload_timer.fireOnce(true);
 
+    // menu toggles, sliders and workspace renames all call save_rc(); write
+    // the file once after such a burst instead of once per change
+    m_save_rc_timer.setTimeout(500 * FbTk::FbTime::IN_MILLISECONDS);
+    m_save_rc_timer.setCommand(FbTk::RefCount<FbTk::Command<void> >(new FluxboxCmd(*this, &Fluxbox::sync_rc)));
+    m_save_rc_timer.fireOnce(true);
+
+    // panels and toolbars may change their struts several times while
+    // handling one batch of events, publish the work area once afterwards
+    m_workarea_timer.setTimeout(1);
+    m_workarea_timer.setCommand(FbTk::RefCount<FbTk::Command<void> >(new FluxboxCmd(*this, &Fluxbox::updateWorkareas)));
+    m_workarea_timer.fireOnce(true);
+
     if (xsync)
         XSynchronize(disp, True);
 
@@ -357,6 +378,7 @@ Fluxbox::Fluxbox(int argc, char **argv,
 
 
     // setup theme manager to have our style file ready to be scanned
+    FbTk::ThemeManager::instance().setCacheDirectory(getDefaultDataFilename("cache"));
     FbTk::ThemeManager::instance().load(getStyleFilename(), getStyleOverlayFilename());
 
     // Create keybindings handler and load keys file
@@ -448,6 +470,9 @@ Fluxbox::Fluxbox(int argc, char **argv,
     // init all "screens"
     STLUtil::forAll(m_screens, std::bind(mem_fn(&Fluxbox::initScreen), this, _1));
 
+    // all themes are loaded now, remember what they asked for
+    FbTk::ThemeManager::instance().saveCache();
+
     XAllowEvents(disp, ReplayPointer, CurrentTime);
 
     //XSynchronize(disp, False);
@@ -474,6 +499,9 @@ Fluxbox::Fluxbox(int argc, char **argv,
 
 Fluxbox::~Fluxbox() {
 
+    if (m_save_rc_timer.isTiming())
+        sync_rc();
+
     // this needs to be destroyed before screens; otherwise, menus stored in
     // key commands cause a segfault when the LayerItem is destroyed
     m_key.reset(0);
@@ -702,8 +730,15 @@ void Fluxbox::handleEvent(XEvent * const e) {
         WinClient *winclient = searchWindow(e->xdestroywindow.window);
         if (winclient != 0) {
             FluxboxWindow *win = winclient->fbwindow();
-            if (win)
+            if (win) {
+#ifdef DEBUG
+                const FbTk::MemoryPool::Stats pool_before = FbTk::MemoryPool::stats();
+#endif // DEBUG
                 win->destroyNotifyEvent(e->xdestroywindow);
+#ifdef DEBUG
+                logPoolRelease("DestroyNotify", e->xdestroywindow.window, pool_before);
+#endif // DEBUG
+            }
         }
 
     }
@@ -804,10 +839,10 @@ void Fluxbox::handleEvent(XEvent * const e) {
 #ifdef HAVE_RANDR1_2
             XRRUpdateConfiguration(e);
 #endif
-            // update root window size in screen
+            // update root window size in screen, once the burst is over
             BScreen *scr = searchScreen(e->xany.window);
             if (scr != 0)
-                scr->updateSize();
+                scr->deferUpdateSize();
         }
 #endif // HAVE_RANDR
 
@@ -839,8 +874,14 @@ void Fluxbox::handleUnmapNotify(XUnmapEvent &ue) {
             return;
         }
 
+#ifdef DEBUG
+        const FbTk::MemoryPool::Stats pool_before = FbTk::MemoryPool::stats();
+#endif // DEBUG
         // this should delete client and adjust m_focused_window if necessary
         win->unmapNotifyEvent(ue);
+#ifdef DEBUG
+        logPoolRelease("UnmapNotify", ue.window, pool_before);
+#endif // DEBUG
 
     // according to http://tronche.com/gui/x/icccm/sec-4.html#s-4.1.4
     // a XWithdrawWindow is
@@ -1027,12 +1068,12 @@ void Fluxbox::removeAtomHandler(AtomHandler *atomh) {
 }
 
 WinClient *Fluxbox::searchWindow(Window window) {
-    WinClientMap::iterator it = m_window_search.find(window);
-    if (it != m_window_search.end())
-        return it->second;
-
-    WindowMap::iterator git = m_window_search_group.find(window);
-    return git == m_window_search_group.end() ? 0 : &git->second->winClient();
+    const WindowSearch *search = m_window_search.find(window);
+    if (search == 0)
+        return 0;
+    if (search->client)
+        return search->client;
+    return search->group ? &search->group->winClient() : 0;
 }
 
 
@@ -1046,12 +1087,12 @@ WinClient *Fluxbox::searchGroup(Window window) {
 */
 
 void Fluxbox::saveWindowSearch(Window window, WinClient *data) {
-    m_window_search[window] = data;
+    m_window_search[window].client = data;
 }
 
 /* some windows relate to the whole group */
 void Fluxbox::saveWindowSearchGroup(Window window, FluxboxWindow *data) {
-    m_window_search_group[window] = data;
+    m_window_search[window].group = data;
 }
 
 void Fluxbox::saveGroupSearch(Window window, WinClient *data) {
@@ -1060,11 +1101,21 @@ void Fluxbox::saveGroupSearch(Window window, WinClient *data) {
 
 
 void Fluxbox::removeWindowSearch(Window window) {
-    m_window_search.erase(window);
+    WindowSearch *search = m_window_search.find(window);
+    if (search == 0)
+        return;
+    search->client = 0;
+    if (search->group == 0)
+        m_window_search.erase(window);
 }
 
 void Fluxbox::removeWindowSearchGroup(Window window) {
-    m_window_search_group.erase(window);
+    WindowSearch *search = m_window_search.find(window);
+    if (search == 0)
+        return;
+    search->group = 0;
+    if (search->client == 0)
+        m_window_search.erase(window);
 }
 
 void Fluxbox::removeGroupSearch(Window window) {
@@ -1093,6 +1144,10 @@ void Fluxbox::shutdown(int x_wants_down) {
     Display *dpy = FbTk::App::instance()->display();
     m_state.shutdown = true;
 
+    // a restarting fluxbox has to read what we were about to write
+    if (m_save_rc_timer.isTiming())
+        sync_rc();
+
 #ifdef HAVE_ALARM
     // give ourself 2 seconds (randomly picked randon number) to shutdown
     // and then try to reenter signal handling. a bad race condition might
@@ -1110,17 +1165,26 @@ void Fluxbox::shutdown(int x_wants_down) {
 
 /// saves resources
 void Fluxbox::save_rc() {
+    m_save_rc_timer.start();
+}
+
+void Fluxbox::sync_rc() {
     _FB_USES_NLS;
-    XrmDatabase new_rc = 0;
+
+    m_save_rc_timer.stop();
 
     string dbfile(getRcFilename());
 
-    if (!dbfile.empty()) {
-        m_resourcemanager.save(dbfile.c_str(), dbfile.c_str());
-        m_screen_rm.save(dbfile.c_str(), dbfile.c_str());
-    } else
+    if (dbfile.empty()) {
         cerr<<_FB_CONSOLETEXT(Fluxbox, BadRCFile, "rc filename is invalid!", "Bad settings file")<<endl;
+        return;
+    }
 
+    // these are static, but may not be saved in the users resource file,
+    // writing these resources will allow the user to edit them at a later
+    // time... but loading the defaults before saving allows us to rewrite the
+    // users changes...
+    vector<string> workspace_names;
 
     ScreenList::iterator it = m_screens.begin();
     ScreenList::iterator it_end = m_screens.end();
@@ -1131,26 +1195,17 @@ void Fluxbox::save_rc() {
         workspaces_string += FbTk::StringUtil::number2String(screen->screenNumber());
         workspaces_string += ".workspaceNames: ";
 
-        // these are static, but may not be saved in the users resource file,
-        // writing these resources will allow the user to edit them at a later
-        // time... but loading the defaults before saving allows us to rewrite the
-        // users changes...
-
         const BScreen::WorkspaceNames& names = screen->getWorkspaceNames();
         for (size_t i=0; i < names.size(); i++) {
             workspaces_string += FbTk::FbStringUtil::FbStrToLocale(names[i]);
             workspaces_string += ',';
         }
 
-        XrmPutLineResource(&new_rc, workspaces_string.c_str());
-
+        workspace_names.push_back(workspaces_string);
     }
 
-    XrmDatabase old_rc = XrmGetFileDatabase(dbfile.c_str());
-
-    XrmMergeDatabases(new_rc, &old_rc);
-    XrmPutFileDatabase(old_rc, dbfile.c_str());
-    XrmDestroyDatabase(old_rc);
+    // m_screen_rm is the same manager, so this writes the screen resources too
+    m_resourcemanager.save(dbfile.c_str(), dbfile.c_str(), &workspace_names);
 
     fbdbg <<"------------ SAVING DONE"<<endl;
 
@@ -1172,6 +1227,11 @@ string Fluxbox::getDefaultDataFilename(const char *name) const {
 void Fluxbox::load_rc() {
     _FB_USES_NLS;
 
+    // a pending save_rc() has to reach the file before we read it back,
+    // or reconfigure right after a change would undo it
+    if (m_save_rc_timer.isTiming())
+        sync_rc();
+
     string dbfile(getRcFilename());
 
     if (!dbfile.empty()) {
@@ -1359,12 +1419,12 @@ void Fluxbox::revertFocus() {
 }
 
 bool Fluxbox::validateClient(const WinClient *client) const {
-    WinClientMap::const_iterator it =
-        find_if(m_window_search.begin(),
-                m_window_search.end(),
-                Compose(std::bind(equal_to<const WinClient *>(), _1, client),
-                        Select2nd<WinClientMap::value_type>()));
-    return it != m_window_search.end();
+    bool found = false;
+    m_window_search.forAll([&found, client](Window, const WindowSearch &search) {
+        if (search.client == client)
+            found = true;
+    });
+    return found;
 }
 
 void Fluxbox::updateFrameExtents(FluxboxWindow &win) {
@@ -1403,8 +1463,14 @@ void Fluxbox::focusedWindowChanged(BScreen &screen,
 }
 
 void Fluxbox::workspaceAreaChanged(BScreen &screen) {
-    STLUtil::forAllIf(m_atomhandler, mem_fn(&AtomHandler::update),
-            CallMemFunWithRefArg<AtomHandler, BScreen&, void>(&AtomHandler::updateWorkarea, screen));
+    m_workarea_timer.start();
+}
+
+void Fluxbox::updateWorkareas() {
+    for (ScreenList::iterator it = m_screens.begin(); it != m_screens.end(); ++it) {
+        STLUtil::forAllIf(m_atomhandler, mem_fn(&AtomHandler::update),
+                CallMemFunWithRefArg<AtomHandler, BScreen&, void>(&AtomHandler::updateWorkarea, **it));
+    }
 }
 
 
@@ -30,6 +30,7 @@
 #include "FbTk/Timer.hh"
 #include "FbTk/Signal.hh"
 #include "FbTk/MenuSearch.hh"
+#include "FbTk/XIDTable.hh"
 
 #include "AttentionNoticeHandler.hh"
 #include "ShortcutManager.hh"
@@ -50,6 +51,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 #include <cstdio>
@@ -146,7 +148,10 @@ public:
     // searchWindow on these windows will give the active client in the group
     void saveWindowSearchGroup(Window win, FluxboxWindow *fbwin);
     void saveGroupSearch(Window win, WinClient *winclient);
+    /// schedule writing the resources, bursts of changes are written once
     void save_rc();
+    /// write pending resource changes now
+    void sync_rc();
     void removeWindowSearch(Window win);
     void removeWindowSearchGroup(Window win);
     void removeGroupSearch(Window win);
@@ -211,6 +216,8 @@ private:
 
     /// Called when the workspace area changed.
     void workspaceAreaChanged(BScreen &screen);
+    /// publishes the work area of all screens
+    void updateWorkareas();
     /// Called when a window (FluxboxWindow) dies
     void windowDied(Focusable &focusable);
     /// Called when a client (WinClient) dies
@@ -223,8 +230,13 @@ private:
     void windowLayerChanged(FluxboxWindow &win);
 
 
-    typedef std::map<Window, WinClient *> WinClientMap;
-    typedef std::map<Window, FluxboxWindow *> WindowMap;
+    /// what searchWindow knows about a window
+    struct WindowSearch {
+        WindowSearch(): client(0), group(0) { }
+        WinClient *client;
+        FluxboxWindow *group; ///< the window relates to the whole group
+    };
+    typedef FbTk::XIDTable<WindowSearch> WindowSearchTable;
     typedef std::set<AtomHandler *> AtomHandlerContainer;
     typedef AtomHandlerContainer::iterator AtomHandlerContainerIt;
 
@@ -267,8 +279,7 @@ private:
     AttentionNoticeHandler m_attention_handler;
 
     ScreenList             m_screens;
-    WinClientMap           m_window_search;
-    WindowMap              m_window_search_group;
+    WindowSearchTable      m_window_search;
 
     // A window is the group leader, which can map to several
     // WinClients in the group, it is *not* fluxbox's concept of groups
@@ -299,6 +310,8 @@ private:
     ///< when we execute reconfig command we must wait until next event round
     FbTk::Timer m_reconfig_timer;
     FbTk::Timer m_key_reload_timer;
+    FbTk::Timer m_save_rc_timer; ///< coalesces save_rc() calls
+    FbTk::Timer m_workarea_timer; ///< coalesces work area updates
     bool m_showing_dialog;
 
     struct {
@@ -0,0 +1,63 @@
+// TestCheck.hh
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#ifndef TESTCHECK_HH
+#define TESTCHECK_HH
+
+#include <cstdarg>
+#include <cstdio>
+
+/**
+ * Checks shared by the unit tests. Each failed check is printed and
+ * counted, and main() returns checkResult() so make check sees failures.
+ */
+namespace TestCheck {
+
+inline int &failures() {
+    static int s_failures = 0;
+    return s_failures;
+}
+
+/// prints "  <what>: failed" unless ok; what is a printf() format
+inline void check(bool ok, const char *what, ...) {
+    if (ok)
+        return;
+
+    va_list args;
+    va_start(args, what);
+    printf("  ");
+    vprintf(what, args);
+    printf(": failed\n");
+    va_end(args);
+    ++failures();
+}
+
+/// @return exit code for main()
+inline int checkResult() {
+    if (failures())
+        printf("%d failures\n", failures());
+    return failures() ? 1 : 0;
+}
+
+} // end namespace TestCheck
+
+#endif // TESTCHECK_HH
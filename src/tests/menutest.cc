@@ -19,38 +19,39 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
 // DEALINGS IN THE SOFTWARE.
 
-#include "App.hh"
-#include "FbWindow.hh"
-#include "Font.hh"
-#include "EventHandler.hh"
-#include "EventManager.hh"
-#include "GContext.hh"
-#include "Color.hh"
-#include "Menu.hh"
-#include "MenuItem.hh"
-#include "MenuSeparator.hh"
-#include "StringUtil.hh"
-#include "ImageControl.hh"
-
-#include "../FbMenuParser.hh"
+#include "FbTk/App.hh"
+#include "FbTk/FbWindow.hh"
+#include "FbTk/Font.hh"
+#include "FbTk/EventHandler.hh"
+#include "FbTk/EventManager.hh"
+#include "FbTk/GContext.hh"
+#include "FbTk/Color.hh"
+#include "FbTk/Menu.hh"
+#include "FbTk/MenuItem.hh"
+#include "FbTk/MenuSeparator.hh"
+#include "FbTk/StringUtil.hh"
+#include "FbTk/ImageControl.hh"
+
+#include "FbMenuParser.hh"
 
 #include <X11/Xutil.h>
 #include <X11/keysym.h>
 
 #include <string>
+#include <cstring>
 #include <iostream>
 using namespace std;
 
-void doSubmenu(Parser &parser, FbTk::Menu &menu, 
+void doSubmenu(FbTk::Parser &parser, FbTk::Menu &menu, 
                FbTk::MenuTheme &theme,
                FbTk::ImageControl &image_ctrl,
                const std::string &labelstr) {
 
-    Parser::Item key, label, cmd, icon;
+    FbTk::Parser::Item key, label, cmd, icon;
 
     FbTk::Menu *submenu = new FbTk::Menu(theme, image_ctrl);
-    submenu->setLabel(labelstr.c_str());
-    menu.insert(labelstr.c_str(), submenu);
+    submenu->setLabel(labelstr);
+    menu.insertSubmenu(labelstr, submenu);
     // skip submenu items
     if (key.second == "begin") {
         while (key.second != "end") {
@@ -74,11 +75,14 @@ public:
         //m_menu_theme.frameFont().setAntialias(true);
         //m_menu_theme.titleFont().setAntialias(true);
 
+        // how much talking to the server building the menu takes
+        unsigned long first_request = XNextRequest(display());
+
         cerr<<"Loading menu: "<<menufile<<endl;
         FbMenuParser parser(menufile);
         if (parser.isLoaded()) { 
             // get start of file
-            Parser::Item key, label, cmd, icon;
+            FbTk::Parser::Item key, label, cmd, icon;
             while (!parser.eof()) {
                 // get first begin line
                 parser>>key>>label>>cmd>>icon;
@@ -87,7 +91,7 @@ public:
                 
             }
 
-            m_menu.setLabel(label.second.c_str());
+            m_menu.setLabel(label.second);
             
             while (!parser.eof()) {
                 parser>>key>>label>>cmd>>icon;
@@ -96,7 +100,7 @@ public:
 
                 string iconfile = icon.second;
                 if (key.second == "separator")
-                    m_menu.insert(new FbTk::MenuSeparator());
+                    m_menu.insertItem(new FbTk::MenuSeparator());
                 else if (key.second == "begin") { // new submenu
                     doSubmenu(parser, m_menu,
                               m_menu_theme,
@@ -117,10 +121,13 @@ public:
         }
 
         cerr<<"Loading style: "<<stylefile<<endl;        
-        FbTk::ThemeManager::instance().load(stylefile);
+        FbTk::ThemeManager::instance().load(stylefile, "");
 
         m_menu.show();
+        // draw the items now, instead of on the first expose
+        m_menu.clearWindow();
 
+        cerr<<"menu took "<<XNextRequest(display()) - first_request<<" requests"<<endl;
     }
 
     ~App() {
@@ -0,0 +1,67 @@
+// testFocusableList.cc
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+// Checks which window signals FocusableList watches for each property a
+// pattern can look at. A property without signals would never match
+// differently after the list was built.
+
+#include "FocusableList.hh"
+#include "TestCheck.hh"
+
+#include <cstdio>
+
+using TestCheck::check;
+using TestCheck::checkResult;
+
+namespace {
+
+void testSignalsFor() {
+    printf("testing FocusableList::signalsFor()\n");
+
+    for (int prop = ClientPattern::TITLE; prop <= ClientPattern::HORZMAX; ++prop) {
+        ClientPattern::WinProperty p = static_cast<ClientPattern::WinProperty>(prop);
+        check(FocusableList::signalsFor(p) != 0, "signals for property %d", prop);
+    }
+
+    // (urgent=yes) has to re-match when the attention handler emits stateSig
+    check(FocusableList::signalsFor(ClientPattern::URGENT) &
+          FocusableList::STATE_SIGNALS, "urgent");
+    check(FocusableList::signalsFor(ClientPattern::XPROP) &
+          FocusableList::PROPERTY_SIGNALS, "xprop");
+    check(FocusableList::signalsFor(ClientPattern::TITLE) &
+          FocusableList::TITLE_SIGNALS, "title");
+    check(FocusableList::signalsFor(ClientPattern::WORKSPACE) &
+          FocusableList::STATE_SIGNALS, "workspace");
+    check(FocusableList::signalsFor(ClientPattern::ROLE) &
+          FocusableList::PROPERTY_SIGNALS, "role");
+
+    printf("done.\n");
+}
+
+} // end anonymous namespace
+
+int main(int argc, char **argv) {
+
+    testSignalsFor();
+
+    return checkResult();
+}
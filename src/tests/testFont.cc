@@ -29,6 +29,9 @@
 #include "FbTk/Color.hh"
 #include "FbTk/FbString.hh"
 #include "FbTk/StringUtil.hh"
+#include "FbTk/TextUtils.hh"
+#include "FbTk/FbPixmap.hh"
+#include "FbTk/FbTime.hh"
 
 #include <X11/Xutil.h>
 #include <X11/keysym.h>
@@ -47,12 +50,14 @@ public:
         FbTk::App(displayname),
         FbTk::FbWindow(DefaultScreen(this->FbTk::App::display()), 0, 0, 640, 480, KeyPressMask|ExposureMask|StructureNotifyMask),
         m_gc(drawable()),
+        m_bg_gc(drawable()),
         m_foreground(foreground.c_str(), screenNumber()),
         m_background(background.c_str(), screenNumber()) {
 
         m_gc.setLineAttributes(1, FbTk::GContext::JOINMITER, FbTk::GContext::LINESOLID, FbTk::GContext::CAPNOTLAST);
         m_gc.setForeground(m_foreground);
         m_gc.setBackground(m_background);
+        m_bg_gc.setForeground(m_background);
         setBackgroundColor(m_background);
 
         FbTk::EventManager::instance()->add(*this, *this);
@@ -100,6 +105,29 @@ public:
         redraw();
     }
 
+    /// time count redraws of text with font, in the given orientation
+    uint64_t bench(const FbTk::BiDiString& text, FbTk::Font& font,
+                   FbTk::Orientation orient, int count) {
+
+        unsigned int w = font.textWidth(text) + 2;
+        unsigned int h = font.height() + 2;
+        int x = 1, y = 1 + font.ascent();
+        FbTk::translateCoords(orient, x, y, w, h);
+        if (orient == FbTk::ROT90 || orient == FbTk::ROT270)
+            std::swap(w, h);
+
+        FbTk::FbPixmap pm(*this, w, h, depth());
+        XSync(FbTk::App::display(), False);
+
+        uint64_t start = FbTk::FbTime::mono();
+        for (int i = 0; i < count; ++i) {
+            pm.fillRectangle(m_bg_gc.gc(), 0, 0, w, h);
+            font.drawText(pm, screenNumber(), m_gc.gc(), text, x, y, orient);
+        }
+        XSync(FbTk::App::display(), False);
+        return FbTk::FbTime::mono() - start;
+    }
+
     void addText(const FbTk::BiDiString& text, FbTk::Font& font, const FbTk::Orientation orient) {
 
         FbTk::FbWindow* win = this;
@@ -116,6 +144,7 @@ public:
 private:
     vector<FbTk::TextButton*> m_buttons;
     FbTk::GContext m_gc;
+    FbTk::GContext m_bg_gc;
     FbTk::Color m_foreground;
     FbTk::Color m_background;
 };
@@ -129,6 +158,7 @@ int main(int argc, char **argv) {
     string displayname("");
     string background("white");
     string foreground("black");
+    int bench = 0;
 
     int a;
     for (a = 1; a < argc; ++a) {
@@ -140,12 +170,15 @@ int main(int argc, char **argv) {
             background = argv[++a];
         } else if (strcmp("-fg", argv[a]) == 0 && a + 1 < argc) {
             foreground = argv[++a];
+        } else if (strcmp("-bench", argv[a]) == 0 && a + 1 < argc) {
+            bench = atoi(argv[++a]);
         } else if (strcmp("-h", argv[a]) == 0) {
             cerr<<"Arguments: \"text|fontname\" [\"text|fontname2\"]"<<endl;
             cerr<<"-display <display>"<<endl;
             cerr<<"-orient"<<endl;
             cerr<<"-fg <foreground color>"<<endl;
             cerr<<"-bg <background color>"<<endl;
+            cerr<<"-bench <count> (time count redraws, straight and rotated)"<<endl;
             cerr<<"-h"<<endl;
             exit(0);
         } else {
@@ -176,6 +209,19 @@ int main(int argc, char **argv) {
                 orient = FbTk::ROT0;
             }
 
+            if (bench > 0) {
+                FbTk::BiDiString text(FbTk::FbStringUtil::XStrToFb(tf[0]));
+                FbTk::Orientation rot = orient ? orient : FbTk::ROT90;
+                uint64_t straight = app.bench(text, *f, FbTk::ROT0, bench);
+                uint64_t rotated = 0;
+                if (f->validOrientation(rot))
+                    rotated = app.bench(text, *f, rot, bench);
+                cout<<tf[1]<<": "<<(double)straight / bench<<" us per label, "
+                    <<(double)rotated / bench<<" us rotated ("<<rot<<")"<<endl;
+                delete f;
+                continue;
+            }
+
             app.addText(FbTk::FbStringUtil::XStrToFb(tf[0]), *f, orient);
 
         } else {
@@ -184,6 +230,9 @@ int main(int argc, char **argv) {
         }
     }
 
+    if (bench > 0)
+        return 0;
+
     app.resize(app.width(), app.height());
     app.redraw();
     app.eventLoop();
@@ -0,0 +1,181 @@
+// testImageTransform.cc
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+// Compares the client side transforms of FbPixmap with the per pixel
+// loops FbPixmap::rotate and FbPixmap::scale used before.
+
+#include "FbTk/ImageTransform.hh"
+#include "TestCheck.hh"
+
+#include <cstdio>
+#include <vector>
+
+using FbTk::Orientation;
+using TestCheck::check;
+using TestCheck::checkResult;
+
+namespace {
+
+struct Image {
+    Image(unsigned int w, unsigned int h):
+        width(w), height(h), pixels(w * h, 0xdeadbeef) { }
+
+    unsigned long pixel(int x, int y) const { return pixels[y * width + x]; }
+    void setPixel(int x, int y, unsigned long p) { pixels[y * width + x] = p; }
+
+    // XDrawPoint outside of the pixmap is clipped
+    void drawPoint(unsigned int x, unsigned int y, unsigned long p) {
+        if (x < width && y < height)
+            setPixel(x, y, p);
+    }
+
+    bool operator == (const Image &other) const {
+        return width == other.width && height == other.height &&
+               pixels == other.pixels;
+    }
+
+    unsigned int width, height;
+    std::vector<unsigned long> pixels;
+};
+
+Image pattern(unsigned int w, unsigned int h) {
+    Image image(w, h);
+    for (unsigned int y = 0; y < h; ++y)
+        for (unsigned int x = 0; x < w; ++x)
+            image.setPixel(x, y, (y << 16) | x);
+    return image;
+}
+
+// the old FbPixmap::scale, with XDrawPoint replaced by drawPoint
+Image oldScale(const Image &src, unsigned int dest_width, unsigned int dest_height) {
+    Image dest(dest_width, dest_height);
+    float zoom_x = static_cast<float>(src.width)/static_cast<float>(dest_width);
+    float zoom_y = static_cast<float>(src.height)/static_cast<float>(dest_height);
+
+    float src_x = 0, src_y = 0;
+    for (unsigned int tx=0; tx < dest_width; ++tx, src_x += zoom_x) {
+        src_y = 0;
+        for (unsigned int ty=0; ty < dest_height; ++ty, src_y += zoom_y) {
+            dest.drawPoint(tx, ty, src.pixel(static_cast<int>(src_x),
+                                             static_cast<int>(src_y)));
+        }
+    }
+    return dest;
+}
+
+// the old FbPixmap::rotate for ROT90 and ROT270
+Image oldRotate(const Image &src, Orientation orient) {
+    unsigned int oldw = src.width, oldh = src.height;
+    unsigned int neww = oldh, newh = oldw;
+    Image dest(neww, newh);
+
+    unsigned int startx = 0, starty = 0;
+    int dirx = 0, diry = 0;
+    if (orient == FbTk::ROT90) {
+        startx = neww-1;
+        starty = 0;
+        dirx = -1;
+        diry = 1;
+    } else {
+        startx = 0;
+        starty = newh-1;
+        dirx = 1;
+        diry = -1;
+    }
+
+    unsigned int srcx, srcy, destx, desty;
+    for (srcy = 0, destx = startx; srcy < oldh; ++srcy, destx+=dirx) {
+        for (srcx = 0, desty = starty; srcx < oldw; ++srcx, desty+=diry) {
+            dest.drawPoint(destx, desty, src.pixel(srcx, srcy));
+        }
+    }
+    return dest;
+}
+
+// ROT180 used to start at (width, height), so it drew everything one
+// pixel off and left the first row and column unset. Compare with what
+// it was meant to do.
+Image rotate180(const Image &src) {
+    Image dest(src.width, src.height);
+    for (unsigned int y = 0; y < src.height; ++y)
+        for (unsigned int x = 0; x < src.width; ++x)
+            dest.setPixel(src.width - 1 - x, src.height - 1 - y, src.pixel(x, y));
+    return dest;
+}
+
+void testScale() {
+    printf("testing ImageTransform::scale()\n");
+
+    const unsigned int sizes[] = { 1, 2, 3, 7, 16, 22, 24, 31, 48, 64, 100, 128 };
+    const size_t nr_sizes = sizeof(sizes)/sizeof(sizes[0]);
+
+    for (size_t a = 0; a < nr_sizes; ++a) {
+        for (size_t b = 0; b < nr_sizes; ++b) {
+            Image src = pattern(sizes[a], sizes[b]);
+            for (size_t c = 0; c < nr_sizes; ++c) {
+                for (size_t d = 0; d < nr_sizes; ++d) {
+                    Image dest(sizes[c], sizes[d]);
+                    FbTk::ImageTransform::scale(src, src.width, src.height,
+                                                dest, dest.width, dest.height);
+                    check(dest == oldScale(src, dest.width, dest.height),
+                          "scale %ux%u -> %ux%u", src.width, src.height, dest.width, dest.height);
+                }
+            }
+        }
+    }
+
+    printf("done.\n");
+}
+
+void testRotate() {
+    printf("testing ImageTransform::rotate()\n");
+
+    const unsigned int sizes[] = { 1, 2, 3, 16, 17, 48, 1000 };
+    const size_t nr_sizes = sizeof(sizes)/sizeof(sizes[0]);
+
+    for (size_t a = 0; a < nr_sizes; ++a) {
+        for (size_t b = 0; b < nr_sizes; ++b) {
+            Image src = pattern(sizes[a], sizes[b]);
+            unsigned int w = src.width, h = src.height;
+
+            Image rot90(h, w), rot180(w, h), rot270(h, w);
+            FbTk::ImageTransform::rotate(src, w, h, rot90, FbTk::ROT90);
+            FbTk::ImageTransform::rotate(src, w, h, rot180, FbTk::ROT180);
+            FbTk::ImageTransform::rotate(src, w, h, rot270, FbTk::ROT270);
+
+            check(rot90 == oldRotate(src, FbTk::ROT90), "rot90 %ux%u -> %ux%u", w, h, h, w);
+            check(rot270 == oldRotate(src, FbTk::ROT270), "rot270 %ux%u -> %ux%u", w, h, h, w);
+            check(rot180 == rotate180(src), "rot180 %ux%u -> %ux%u", w, h, w, h);
+        }
+    }
+
+    printf("done.\n");
+}
+
+} // end anonymous namespace
+
+int main(int argc, char **argv) {
+
+    testScale();
+    testRotate();
+
+    return checkResult();
+}
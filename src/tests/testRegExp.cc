@@ -0,0 +1,157 @@
+// testRegExp.cc
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+// Checks that FbTk::RegExp matches like a plain regexec, and compares
+// how long both take for typical ClientPattern terms.
+
+#include "FbTk/RegExp.hh"
+#include "FbTk/FbTime.hh"
+#include "TestCheck.hh"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#ifdef USE_REGEXP
+
+using std::string;
+using TestCheck::check;
+using TestCheck::checkResult;
+
+namespace {
+
+/// what FbTk::RegExp used to do for each match
+class PlainRegExp {
+public:
+    PlainRegExp(const string &str, bool full_match) {
+        string match = full_match ? "^" + str + "$" : str;
+        m_ok = regcomp(&m_regex, match.c_str(), REG_NOSUB | REG_EXTENDED) == 0;
+    }
+    ~PlainRegExp() {
+        if (m_ok)
+            regfree(&m_regex);
+    }
+    bool error() const { return !m_ok; }
+    bool match(const string &str) const {
+        return m_ok && regexec(&m_regex, str.c_str(), 0, 0, 0) == 0;
+    }
+private:
+    regex_t m_regex;
+    bool m_ok;
+};
+
+const char *patterns[] = {
+    "", "xterm", "XTerm", "Firefox", "x", "term", ".*term", "xterm.*",
+    ".*ter.*", ".*", "^xterm", "xterm$", "^xterm$", "x\\.term", "x\\\\",
+    "\\$HOME", "a\\$", "1\\.5.*", "xterm\\.*", ".*\\.*", "x.erm",
+    "(xterm|urxvt)", "[Xx]term", "xterm+", "\\wterm", "^$", "^", "$",
+    "^.*$", "term.*$", "^.*term"
+};
+
+const char *strings[] = {
+    "", "xterm", "XTerm", "xterm ", " xterm", "term", "firefox", "Firefox",
+    "x.term", "xxterm", "x\\", "$HOME", "a$", "1.5 beta", "1x5", "urxvt",
+    "xterm.", "xterm...", "x", ".", "~/src/fluxbox - vim"
+};
+
+const size_t nr_patterns = sizeof(patterns)/sizeof(patterns[0]);
+const size_t nr_strings = sizeof(strings)/sizeof(strings[0]);
+
+void testMatch() {
+    printf("testing RegExp::match()\n");
+
+    for (size_t p = 0; p < nr_patterns; ++p) {
+        for (int full = 0; full < 2; ++full) {
+            FbTk::RegExp regexp(patterns[p], full);
+            PlainRegExp plain(patterns[p], full);
+            if (regexp.error() != plain.error()) {
+                check(false, "\"%s\" (%d): error()", patterns[p], full);
+                continue;
+            }
+            // twice, the second time it might come from the cache
+            for (int round = 0; round < 2; ++round) {
+                for (size_t s = 0; s < nr_strings; ++s) {
+                    check(regexp.match(strings[s]) == plain.match(strings[s]),
+                          "\"%s\" (%d) on \"%s\"", patterns[p], full, strings[s]);
+                }
+            }
+        }
+    }
+
+    printf("done.\n");
+}
+
+template <typename T>
+uint64_t timeMatches(const char *pattern, const std::vector<string> &names,
+                     unsigned int rounds, size_t &hits) {
+    T regexp(pattern, true);
+    hits = 0;
+    uint64_t start = FbTk::FbTime::mono();
+    for (unsigned int r = 0; r < rounds; ++r)
+        for (size_t i = 0; i < names.size(); ++i)
+            hits += regexp.match(names[i]);
+    return FbTk::FbTime::mono() - start;
+}
+
+void benchmark() {
+    printf("benchmarking RegExp::match() against regexec\n");
+
+    // what the windows of a busy workspace might be called
+    std::vector<string> names;
+    const char *base[] = { "xterm", "Firefox", "Navigator", "urxvt", "Gimp",
+                           "emacs", "Thunderbird", "mpv", "Pidgin", "XTerm" };
+    for (size_t i = 0; i < 40; ++i)
+        names.push_back(base[i % 10]);
+
+    const char *bench[] = { "xterm", "Firefox.*", ".*term", "[Xx]term" };
+    const unsigned int rounds = 20000;
+
+    for (size_t b = 0; b < sizeof(bench)/sizeof(bench[0]); ++b) {
+        size_t hits, plain_hits;
+        uint64_t t = timeMatches<FbTk::RegExp>(bench[b], names, rounds, hits);
+        uint64_t p = timeMatches<PlainRegExp>(bench[b], names, rounds, plain_hits);
+        printf("  %-12s RegExp %6lu us, regexec %6lu us\n", bench[b],
+               (unsigned long)t, (unsigned long)p);
+        check(hits == plain_hits, "%s: number of matches", bench[b]);
+    }
+
+    printf("done.\n");
+}
+
+} // end anonymous namespace
+
+int main(int argc, char **argv) {
+
+    testMatch();
+    benchmark();
+
+    return checkResult();
+}
+
+#else // notdef USE_REGEXP
+
+int main(int argc, char **argv) {
+    printf("built without regular expressions, nothing to test\n");
+    return 0;
+}
+
+#endif // USE_REGEXP
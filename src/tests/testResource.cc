@@ -0,0 +1,116 @@
+// testResource.cc
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+// Checks that ResourceManager::save() replaces the file a symlink points
+// to and keeps its permissions.
+
+#include "FbTk/Resource.hh"
+#include "TestCheck.hh"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using std::string;
+using TestCheck::check;
+using TestCheck::checkResult;
+
+namespace FbTk {
+
+template<>
+void Resource<int>::setFromString(const char *strval) {
+    *this = atoi(strval);
+}
+
+template<>
+string Resource<int>::getString() const {
+    char strval[32];
+    sprintf(strval, "%d", **this);
+    return strval;
+}
+
+} // end namespace FbTk
+
+namespace {
+
+void testSaveThroughSymlink(const string &dir) {
+    printf("testing ResourceManager::save() through a symlink\n");
+
+    const string real_file = dir + "/real-init";
+    const string link_file = dir + "/init";
+
+    FILE *f = fopen(real_file.c_str(), "w");
+    if (f == 0) {
+        check(false, "create file");
+        return;
+    }
+    fputs("session.test: 1\n", f);
+    fclose(f);
+    chmod(real_file.c_str(), 0600);
+    check(symlink("real-init", link_file.c_str()) == 0, "create symlink");
+
+    {
+        FbTk::ResourceManager rm(link_file.c_str(), false);
+        FbTk::Resource<int> val(rm, 0, "session.test", "Session.Test");
+        check(rm.load(link_file.c_str()), "load");
+        check(*val == 1, "loaded value");
+
+        val = 2;
+        check(rm.save(link_file.c_str()), "save");
+    }
+
+    struct stat buf;
+    check(lstat(link_file.c_str(), &buf) == 0 && S_ISLNK(buf.st_mode),
+          "symlink kept");
+    check(stat(real_file.c_str(), &buf) == 0 && (buf.st_mode & 07777) == 0600,
+          "permissions kept");
+    check(access((real_file + ".tmp").c_str(), F_OK) != 0, "no temporary file");
+
+    FbTk::ResourceManager rm(link_file.c_str(), false);
+    FbTk::Resource<int> val(rm, 0, "session.test", "Session.Test");
+    check(rm.load(link_file.c_str()) && *val == 2, "saved value");
+
+    unlink(link_file.c_str());
+    unlink(real_file.c_str());
+
+    printf("done.\n");
+}
+
+} // end anonymous namespace
+
+int main(int argc, char **argv) {
+
+    char dir[] = "/tmp/testResourceXXXXXX";
+    if (mkdtemp(dir) == 0) {
+        printf("can't create a temporary directory\n");
+        return 1;
+    }
+
+    testSaveThroughSymlink(dir);
+
+    rmdir(dir);
+
+    return checkResult();
+}
@@ -0,0 +1,302 @@
+// testSignal.cc
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+// Checks the FbTk::Signal semantics the rest of fluxbox relies on, and
+// that connecting and emitting don't allocate once the pools are warm.
+
+#include "FbTk/Signal.hh"
+#include "FbTk/MemFun.hh"
+#include "FbTk/FbTime.hh"
+#include "TestCheck.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+using TestCheck::check;
+using TestCheck::checkResult;
+
+namespace {
+
+size_t allocations = 0;
+
+} // end anonymous namespace
+
+void *operator new(size_t size) {
+    ++allocations;
+    void *p = malloc(size ? size : 1);
+    if (p == 0)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+namespace {
+
+struct Recorder {
+    void record(int value) { values.push_back(value); }
+    std::vector<int> values;
+};
+
+std::string str(const std::vector<int> &values) {
+    std::string s;
+    for (size_t i = 0; i < values.size(); ++i)
+        s += static_cast<char>('0' + values[i]);
+    return s;
+}
+
+void testEmit() {
+    printf("testing Signal\n");
+
+    Recorder rec;
+    FbTk::Signal<int> sig;
+    FbTk::Signal<int>::SlotID a = sig.connect([&rec](int v) { rec.record(v); });
+    sig.connect([&rec](int v) { rec.record(v + 1); });
+    sig.connect(FbTk::MemFun(rec, &Recorder::record));
+
+    sig.emit(1);
+    check(str(rec.values) == "121", "emit in connection order");
+
+    rec.values.clear();
+    sig.disconnect(a);
+    sig.disconnect(a);
+    sig.emit(3);
+    check(str(rec.values) == "43", "disconnect");
+
+    rec.values.clear();
+    sig.clear();
+    sig.emit(1);
+    check(rec.values.empty(), "clear");
+
+    // a slot can disconnect itself and others while the signal is emitted
+    FbTk::Signal<int>::SlotID self, later;
+    self = sig.connect([&](int v) {
+        rec.record(v);
+        sig.disconnect(self);
+        sig.disconnect(later);
+    });
+    later = sig.connect([&rec](int v) { rec.record(9); });
+    sig.connect([&rec](int v) { rec.record(v + 1); });
+    sig.emit(1);
+    sig.emit(5);
+    check(str(rec.values) == "126", "disconnect during emit");
+
+    // slots connected during emit are called by the same emit
+    rec.values.clear();
+    sig.clear();
+    bool connected = false;
+    sig.connect([&](int v) {
+        rec.record(v);
+        if (!connected) {
+            connected = true;
+            sig.connect([&rec](int v) { rec.record(v + 1); });
+        }
+    });
+    sig.emit(1);
+    check(str(rec.values) == "12", "connect during emit");
+
+    // a stale handle must not disconnect whoever reuses its connection
+    rec.values.clear();
+    sig.clear();
+    FbTk::Signal<int>::SlotID stale = sig.connect([&rec](int v) { rec.record(v); });
+    sig.disconnect(stale);
+    sig.connect([&rec](int v) { rec.record(v); });
+    sig.disconnect(stale);
+    sig.emit(7);
+    check(str(rec.values) == "7", "stale handle");
+
+    // connectSlot keeps a reference counted slot alive
+    rec.values.clear();
+    sig.clear();
+    FbTk::RefCount<FbTk::Slot<void, int> > ref(
+        new FbTk::SlotImpl<FbTk::MemFun1<void, Recorder, int>, void, int>(
+            FbTk::MemFun(rec, &Recorder::record)));
+    sig.connectSlot(ref);
+    ref = FbTk::RefCount<FbTk::Slot<void, int> >();
+    sig.emit(4);
+    check(str(rec.values) == "4", "connectSlot");
+
+    printf("done.\n");
+}
+
+struct Listener: public FbTk::SignalTracker {
+    Listener(Recorder &r, int v): rec(r), value(v) { }
+    void call() { rec.record(value); }
+    Recorder &rec;
+    int value;
+};
+
+void testTracker() {
+    printf("testing SignalTracker\n");
+
+    Recorder rec;
+    FbTk::Signal<> sig;
+    {
+        Listener one(rec, 1), two(rec, 2);
+        one.join(sig, FbTk::MemFun(one, &Listener::call));
+        // joining the same signal twice has no effect
+        one.join(sig, FbTk::MemFun(one, &Listener::call));
+        two.join(sig, FbTk::MemFun(two, &Listener::call));
+        sig.emit();
+        check(str(rec.values) == "12", "join");
+
+        rec.values.clear();
+        one.leave(sig);
+        sig.emit();
+        check(str(rec.values) == "2", "leave");
+    }
+    rec.values.clear();
+    sig.emit();
+    check(rec.values.empty(), "tracker dies first");
+
+    {
+        Listener three(rec, 3);
+        {
+            FbTk::Signal<> temp;
+            three.join(temp, FbTk::MemFun(three, &Listener::call));
+            three.join(sig, FbTk::MemFun(three, &Listener::call));
+        }
+        // the tracker mustn't touch the dead signal
+        three.leaveAll();
+    }
+
+    // a tracker destroyed by a slot of the signal it tracks
+    Listener *victim = new Listener(rec, 4);
+    Listener killer(rec, 5);
+    killer.join(sig, [&victim]() { delete victim; victim = 0; });
+    victim->join(sig, FbTk::MemFun(*victim, &Listener::call));
+    rec.values.clear();
+    sig.emit();
+    sig.emit();
+    check(rec.values.empty() && victim == 0, "tracker dies during emit");
+
+    printf("done.\n");
+}
+
+struct Counter {
+    void count(int v) { total += v; }
+    long total;
+};
+
+void testAllocations() {
+    printf("testing allocations\n");
+
+    Counter counter = { 0 };
+    FbTk::Signal<int> sig;
+    FbTk::SignalTracker tracker;
+    std::vector<FbTk::Signal<int>::SlotID> ids(32);
+
+    // warm up the pools and the tracker
+    for (size_t i = 0; i < ids.size(); ++i)
+        ids[i] = sig.connect(FbTk::MemFun(counter, &Counter::count));
+    tracker.join(sig, FbTk::MemFun(counter, &Counter::count));
+    tracker.leave(sig);
+    sig.clear();
+
+    size_t before = allocations;
+    for (int round = 0; round < 1000; ++round) {
+        for (size_t i = 0; i < ids.size(); ++i)
+            ids[i] = sig.connect(FbTk::MemFun(counter, &Counter::count));
+        tracker.join(sig, FbTk::MemFun(counter, &Counter::count));
+        sig.emit(1);
+        tracker.leave(sig);
+        for (size_t i = 0; i < ids.size(); ++i)
+            sig.disconnect(ids[i]);
+    }
+    check(allocations == before, "no allocations in steady state");
+    check(counter.total == 1000 * 33, "all slots called");
+
+    printf("done.\n");
+}
+
+void bench() {
+    const int ROUNDS = 200000;
+    Counter counter = { 0 };
+    FbTk::Signal<int> sig;
+
+    size_t before = allocations;
+    uint64_t start = FbTk::FbTime::mono();
+    for (int i = 0; i < ROUNDS; ++i) {
+        FbTk::Signal<int>::SlotID id = sig.connect(FbTk::MemFun(counter, &Counter::count));
+        sig.disconnect(id);
+    }
+    uint64_t connect_time = FbTk::FbTime::mono() - start;
+    size_t connect_allocs = allocations - before;
+
+    for (int i = 0; i < 8; ++i)
+        sig.connect(FbTk::MemFun(counter, &Counter::count));
+
+    before = allocations;
+    start = FbTk::FbTime::mono();
+    for (int i = 0; i < ROUNDS; ++i)
+        sig.emit(1);
+    uint64_t emit_time = FbTk::FbTime::mono() - start;
+    size_t emit_allocs = allocations - before;
+
+    // as many signals as the Fluxbox tracker has with a few hundred windows
+    std::vector<FbTk::Signal<int> > sigs(1000);
+    FbTk::SignalTracker tracker;
+    for (size_t i = 0; i < sigs.size(); ++i)
+        tracker.join(sigs[i], FbTk::MemFun(counter, &Counter::count));
+
+    start = FbTk::FbTime::mono();
+    for (int i = 0; i < ROUNDS; ++i) {
+        FbTk::Signal<int> &s = sigs[(i * 7) % sigs.size()];
+        tracker.leave(s);
+        tracker.join(s, FbTk::MemFun(counter, &Counter::count));
+    }
+    uint64_t track_time = FbTk::FbTime::mono() - start;
+
+    printf("  connect+disconnect: %6.1f ns, %lu allocations\n",
+           connect_time * 1000.0 / ROUNDS, static_cast<unsigned long>(connect_allocs));
+    printf("  emit to 8 slots:    %6.1f ns, %lu allocations (%ld)\n",
+           emit_time * 1000.0 / ROUNDS, static_cast<unsigned long>(emit_allocs),
+           counter.total);
+    printf("  leave+join, %lu tracked: %6.1f ns\n",
+           static_cast<unsigned long>(sigs.size()), track_time * 1000.0 / ROUNDS);
+}
+
+} // end anonymous namespace
+
+int main(int argc, char **argv) {
+
+    testEmit();
+    testTracker();
+    testAllocations();
+
+    if (argc > 1 && strcmp(argv[1], "-bench") == 0) {
+        printf("connect/emit\n");
+        bench();
+    }
+
+    return checkResult();
+}
@@ -0,0 +1,226 @@
+// testWindowLayout.cc
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+#include "WindowLayout.hh"
+#include "TestCheck.hh"
+
+#include <cstdio>
+#include <vector>
+
+using namespace WindowLayout;
+using TestCheck::check;
+using TestCheck::checkResult;
+
+namespace {
+
+Box box(int left, int top, int right, int bottom) {
+    Box b = { left, top, right, bottom };
+    return b;
+}
+
+Frame frame(int x, int y, unsigned int w, unsigned int h,
+            bool shaded = false, bool focused = false) {
+    Frame f = { x, y, w, h, 0, 0, 0, 0, shaded, focused };
+    return f;
+}
+
+Window window(int x, int y, int w, int h, int layer = 0) {
+    Window win = { box(x, y, x + w, y + h),
+                   static_cast<unsigned int>(w), static_cast<unsigned int>(h),
+                   layer, true };
+    return win;
+}
+
+bool overlap(const Box &a, const Box &b) {
+    return a.left < b.right && b.left < a.right &&
+           a.top < b.bottom && b.top < a.bottom;
+}
+
+bool inside(const Box &a, const Box &head) {
+    return a.left >= head.left && a.right <= head.right &&
+           a.top >= head.top && a.bottom <= head.bottom;
+}
+
+Box boxOf(const Geometry &geom) {
+    return box(geom.x, geom.y, geom.x + geom.width, geom.y + geom.height);
+}
+
+/// the geometries tile head without gaps or overlap
+bool tiles(const std::vector<Geometry> &result, const Box &head) {
+    long area = 0;
+    for (size_t i = 0; i < result.size(); ++i) {
+        if (!inside(boxOf(result[i]), head))
+            return false;
+        for (size_t j = i + 1; j < result.size(); ++j)
+            if (overlap(boxOf(result[i]), boxOf(result[j])))
+                return false;
+        area += long(result[i].width) * result[i].height;
+    }
+    return area == long(head.right - head.left) * (head.bottom - head.top);
+}
+
+void testArrange() {
+    printf("testing WindowLayout::arrange()\n");
+
+    const Box head = box(0, 0, 1200, 900);
+    std::vector<Frame> frames;
+    std::vector<Geometry> result;
+
+    arrange(UNSPECIFIED, head, frames, result);
+    check(result.empty(), "no windows");
+
+    for (int i = 0; i < 4; ++i)
+        frames.push_back(frame(i * 10, i * 10, 300, 200));
+    arrange(UNSPECIFIED, head, frames, result);
+    check(result.size() == 4 && tiles(result, head), "2x2 grid");
+    check(result[0].width == 600 && result[0].height == 450, "2x2 cell size");
+
+    frames.pop_back();
+    arrange(VERTICAL, head, frames, result);
+    check(result.size() == 3 && tiles(result, head), "vertical");
+    check(result[0].height == 900, "vertical columns");
+    arrange(HORIZONTAL, head, frames, result);
+    check(result.size() == 3 && tiles(result, head), "horizontal");
+    check(result[0].width == 1200, "horizontal rows");
+
+    // the focused window gets one half, the rest is tiled on the other
+    frames[1].focused = true;
+    arrange(STACKLEFT, head, frames, result);
+    check(result.size() == 3 && tiles(result, head), "stackleft");
+    check(result[1].x == 600 && result[1].width == 600 &&
+          result[1].height == 900, "stackleft main window");
+    arrange(STACKRIGHT, head, frames, result);
+    check(result.size() == 3 && tiles(result, head), "stackright");
+    check(result[1].x == 0 && result[1].width == 600, "stackright main window");
+    arrange(STACKBOTTOM, head, frames, result);
+    check(result.size() == 3 && tiles(result, head), "stackbottom");
+    check(result[1].y == 0 && result[1].height == 450, "stackbottom main window");
+
+    // without focus the last window is the main one
+    frames[1].focused = false;
+    arrange(STACKRIGHT, head, frames, result);
+    check(result.size() == 3 && result[2].x == 0 && result[2].width == 600,
+          "stackright without focus");
+
+    // shaded windows only move, to the top of the head
+    frames.push_back(frame(300, 300, 200, 20, true));
+    arrange(UNSPECIFIED, head, frames, result);
+    check(result.size() == 4 && !result[3].resize &&
+          result[3].x == 1000 && result[3].y == 0, "shaded window");
+    for (size_t i = 0; i < 3; ++i)
+        check(result[i].resize && result[i].y >= 20, "below shaded window");
+
+    // decorations are not part of the client size
+    frames.clear();
+    frames.push_back(frame(0, 0, 100, 100));
+    frames.back().y_offset = 20;
+    frames.back().height_offset = 20;
+    arrange(UNSPECIFIED, head, frames, result);
+    check(result.size() == 1 && result[0].y == 20 && result[0].height == 880,
+          "decorations");
+
+    // only shaded windows are not worth arranging
+    frames.clear();
+    frames.push_back(frame(0, 0, 100, 20, true));
+    arrange(UNSPECIFIED, head, frames, result);
+    check(result.empty(), "only shaded windows");
+
+    printf("done.\n");
+}
+
+void testMinOverlap() {
+    printf("testing WindowLayout::minOverlap()\n");
+
+    const Box head = box(0, 0, 1000, 800);
+    Order rows = { false, false, false };
+    Order cols = { true, false, false };
+    Order right_to_left = { false, true, false };
+    std::vector<Window> windows;
+    int x, y;
+
+    minOverlap(head, 100, 100, 0, windows, rows, x, y);
+    check(x == 0 && y == 0, "empty head");
+
+    windows.push_back(window(0, 0, 100, 100));
+    minOverlap(head, 100, 100, 0, windows, rows, x, y);
+    check(x == 100 && y == 0, "next in row");
+    minOverlap(head, 100, 100, 0, windows, cols, x, y);
+    check(x == 0 && y == 100, "next in column");
+    minOverlap(head, 100, 100, 0, windows, right_to_left, x, y);
+    check(x == 900 && y == 0, "right to left");
+
+    // windows without a place don't count
+    windows.back().placed = false;
+    minOverlap(head, 100, 100, 0, windows, rows, x, y);
+    check(x == 0 && y == 0, "unplaced window");
+
+    // a full head gives the spot with the least overlap
+    windows.clear();
+    windows.push_back(window(0, 0, 1000, 400));
+    windows.push_back(window(0, 400, 500, 400));
+    windows.push_back(window(500, 400, 500, 400));
+    windows.push_back(window(0, 0, 1000, 400));
+    minOverlap(head, 100, 100, 0, windows, rows, x, y);
+    check(y >= 400, "least overlap");
+
+    printf("done.\n");
+}
+
+void testUnclutter() {
+    printf("testing WindowLayout::unclutter()\n");
+
+    const Box head = box(0, 0, 1000, 800);
+    Order rows = { false, false, false };
+    std::vector<Window> windows;
+    std::vector<size_t> indices;
+
+    // a pile of windows, and one which stays where it is
+    for (size_t i = 0; i < 12; ++i) {
+        windows.push_back(window(10 * i, 10 * i, 200 + 10 * i, 150));
+        indices.push_back(i);
+    }
+    windows.push_back(window(400, 300, 200, 200));
+
+    unclutter(head, rows, indices, windows);
+    bool ok = true;
+    for (size_t i = 0; i < windows.size(); ++i) {
+        ok = ok && windows[i].placed && inside(windows[i].box, head);
+        for (size_t j = i + 1; j < windows.size(); ++j)
+            ok = ok && !overlap(windows[i].box, windows[j].box);
+    }
+    check(ok, "no overlap");
+    check(windows.back().box.left == 400 && windows.back().box.top == 300,
+          "unmatched window stays");
+
+    printf("done.\n");
+}
+
+} // end anonymous namespace
+
+int main(int argc, char **argv) {
+
+    testArrange();
+    testMinOverlap();
+    testUnclutter();
+
+    return checkResult();
+}
@@ -0,0 +1,188 @@
+// testXIDTable.cc
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+
+// Checks FbTk::XIDTable against std::map, and compares the cost of the
+// window lookups done for each X event.
+
+#include "FbTk/XIDTable.hh"
+#include "FbTk/FbTime.hh"
+#include "TestCheck.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <vector>
+
+using TestCheck::check;
+using TestCheck::checkResult;
+
+namespace {
+
+/// XIDs as the server hands them out: a client base plus a counter
+XID makeXID(unsigned int client, unsigned int n) {
+    return (static_cast<XID>(client) << 21) | n;
+}
+
+void testTable() {
+    printf("testing XIDTable\n");
+
+    FbTk::XIDTable<int> table;
+    std::map<XID, int> reference;
+
+    check(table.find(1) == 0, "find in empty table");
+
+    srand(42);
+    for (int round = 0; round < 200000; ++round) {
+        // a small key range, so the same keys are inserted and erased often
+        XID xid = makeXID(1 + rand() % 3, rand() % 2000);
+        if (rand() % 7 == 0)
+            xid = None;
+        if (rand() % 3 == 0) {
+            table.erase(xid);
+            reference.erase(xid);
+        } else {
+            table[xid] = round;
+            reference[xid] = round;
+        }
+    }
+
+    check(table.size() == reference.size(), "size %lu",
+          static_cast<unsigned long>(table.size()));
+
+    std::map<XID, int>::const_iterator it = reference.begin();
+    for (; it != reference.end(); ++it) {
+        const int *value = table.find(it->first);
+        check(value != 0 && *value == it->second, "find 0x%lx", it->first);
+    }
+
+    size_t count = 0;
+    table.forAll([&count, &reference](XID xid, int value) {
+        ++count;
+        std::map<XID, int>::const_iterator found = reference.find(xid);
+        check(found != reference.end() && found->second == value, "forAll 0x%lx", xid);
+    });
+    check(count == reference.size(), "forAll count %lu",
+          static_cast<unsigned long>(count));
+
+    for (unsigned int n = 0; n < 2000; ++n) {
+        for (unsigned int client = 1; client <= 3; ++client) {
+            XID xid = makeXID(client, n);
+            check((table.find(xid) != 0) == (reference.count(xid) != 0), "membership 0x%lx", xid);
+        }
+    }
+
+    table.clear();
+    check(table.empty() && table.find(reference.begin()->first) == 0, "clear");
+
+    printf("done.\n");
+}
+
+struct Handlers {
+    Handlers(): handler(0), parent(0) { }
+    void *handler;
+    void *parent;
+};
+
+struct Search {
+    Search(): client(0), group(0) { }
+    void *client;
+    void *group;
+};
+
+/**
+   An event costs EventManager one lookup for the event window, one for
+   its parent, and Fluxbox one more in searchWindow. Before, those were
+   two maps in EventManager and two in Fluxbox.
+ */
+void benchDispatch(size_t frames, size_t events) {
+    // every frame has about a dozen windows: buttons, label, handle, grips, tabs
+    std::vector<XID> windows;
+    for (size_t f = 0; f < frames; ++f)
+        for (unsigned int w = 0; w < 12; ++w)
+            windows.push_back(makeXID(1 + f % 4, (f * 12 + w) * 3));
+
+    std::map<XID, void *> handlers, parents, clients, groups;
+    FbTk::XIDTable<Handlers> table;
+    FbTk::XIDTable<Search> search;
+    for (size_t i = 0; i < windows.size(); ++i) {
+        handlers[windows[i]] = &windows[i];
+        table[windows[i]].handler = &windows[i];
+        if (i % 12 == 0) {
+            parents[windows[i]] = &windows[i];
+            clients[windows[i]] = &windows[i];
+            table[windows[i]].parent = &windows[i];
+            search[windows[i]].client = &windows[i];
+        }
+    }
+
+    std::vector<XID> sequence(events);
+    for (size_t i = 0; i < events; ++i)
+        sequence[i] = windows[rand() % windows.size()];
+
+    size_t hits = 0;
+    uint64_t start = FbTk::FbTime::mono();
+    for (size_t i = 0; i < events; ++i) {
+        XID xid = sequence[i];
+        std::map<XID, void *>::const_iterator it = handlers.find(xid);
+        hits += it != handlers.end();
+        hits += parents.find(xid - xid % 36) != parents.end();
+        if (clients.find(xid) != clients.end())
+            ++hits;
+        else
+            hits += groups.find(xid) != groups.end();
+    }
+    uint64_t map_time = FbTk::FbTime::mono() - start;
+
+    start = FbTk::FbTime::mono();
+    for (size_t i = 0; i < events; ++i) {
+        XID xid = sequence[i];
+        const Handlers *entry = table.find(xid);
+        hits += entry && entry->handler;
+        entry = table.find(xid - xid % 36);
+        hits += entry && entry->parent;
+        const Search *found = search.find(xid);
+        hits += found && (found->client || found->group);
+    }
+    uint64_t table_time = FbTk::FbTime::mono() - start;
+
+    printf("  %5lu windows: std::map %6.1f ns/event, XIDTable %6.1f ns/event (%lu)\n",
+           static_cast<unsigned long>(windows.size()),
+           map_time * 1000.0 / events, table_time * 1000.0 / events,
+           static_cast<unsigned long>(hits));
+}
+
+} // end anonymous namespace
+
+int main(int argc, char **argv) {
+
+    testTable();
+
+    if (argc > 1 && strcmp(argv[1], "-bench") == 0) {
+        printf("dispatch lookups\n");
+        benchDispatch(10, 2000000);
+        benchDispatch(100, 2000000);
+        benchDispatch(500, 2000000);
+    }
+
+    return checkResult();
+}
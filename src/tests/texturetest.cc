@@ -70,6 +70,9 @@ private:
 
     void renderPixmaps() {
 
+        // how much talking to the server the rendering takes
+        unsigned long first_request = XNextRequest(display());
+
         m_gc.setForeground(Color("gray", screenNumber()));
 
         m_background.fillRectangle(m_gc.gc(),
@@ -105,7 +108,7 @@ private:
 
         }
 
-
+        printf("rendering took %lu requests\n", XNextRequest(display()) - first_request);
     }
 
 
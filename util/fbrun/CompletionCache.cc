@@ -0,0 +1,281 @@
+// CompletionCache.cc
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#include "CompletionCache.hh"
+
+#include "FbTk/FileUtil.hh"
+
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef HAVE_SYS_WAIT_H
+#include <sys/wait.h>
+#endif // HAVE_SYS_WAIT_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <algorithm>
+
+using std::string;
+using std::vector;
+using std::ifstream;
+using std::ofstream;
+
+namespace {
+
+const char CACHE_MAGIC[] = "fbrun-completion 1";
+
+bool isPrefix(const string &prefix, const string &str) {
+    return str.compare(0, prefix.size(), prefix) == 0;
+}
+
+struct CompareFrequency {
+    explicit CompareFrequency(const std::map<string, unsigned int> &freq):
+        m_freq(freq) { }
+
+    unsigned int frequency(const string &name) const {
+        std::map<string, unsigned int>::const_iterator it = m_freq.find(name);
+        return it == m_freq.end() ? 0 : it->second;
+    }
+
+    bool operator()(const string &a, const string &b) const {
+        return frequency(a) > frequency(b);
+    }
+
+    const std::map<string, unsigned int> &m_freq;
+};
+
+} // end anonymous namespace
+
+CompletionCache::CompletionCache():
+    m_builder(0),
+    m_loaded(false) {
+}
+
+CompletionCache::~CompletionCache() {
+#ifdef HAVE_FORK
+    // don't leave a zombie behind, the child finishes the file on its own
+    if (m_builder > 0)
+        waitpid(m_builder, 0, WNOHANG);
+#endif // HAVE_FORK
+}
+
+void CompletionCache::prepare(const string &cache_file) {
+    if (m_loaded || m_builder > 0)
+        return;
+
+    m_cache_file = cache_file;
+    if (m_cache_file.empty())
+        return;
+
+#ifdef HAVE_FORK
+    pid_t pid = fork();
+    if (pid == 0) {
+        // the child shares our X connection; it must never touch it,
+        // so leave via _exit() and skip all destructors
+        vector<string> entries;
+        update(entries);
+        _exit(0);
+    }
+    if (pid > 0)
+        m_builder = pid;
+#endif // HAVE_FORK
+}
+
+void CompletionCache::load() {
+    if (m_loaded)
+        return;
+    m_loaded = true;
+
+#ifdef HAVE_FORK
+    if (m_builder > 0) {
+        waitpid(m_builder, 0, 0);
+        m_builder = 0;
+    }
+#endif // HAVE_FORK
+
+    // normally the builder left a valid file for us, otherwise this
+    // rebuilds it in the foreground
+    update(m_entries);
+}
+
+void CompletionCache::setEntries(const vector<string> &entries) {
+    m_entries = entries;
+    std::sort(m_entries.begin(), m_entries.end());
+    m_entries.erase(std::unique(m_entries.begin(), m_entries.end()), m_entries.end());
+    m_loaded = true;
+}
+
+void CompletionCache::setHistory(const vector<string> &history) {
+    m_frequency.clear();
+    for (size_t i = 0; i < history.size(); ++i) {
+        const string &cmd = history[i];
+        size_t start = cmd.find_first_not_of(" \t");
+        if (start == string::npos)
+            continue;
+        size_t end = cmd.find_first_of(" \t", start);
+        string name = cmd.substr(start, end == string::npos ? string::npos : end - start);
+        size_t slash = name.find_last_of('/');
+        if (slash != string::npos)
+            name.erase(0, slash + 1);
+        if (!name.empty())
+            ++m_frequency[name];
+    }
+}
+
+void CompletionCache::find(const string &prefix, vector<string> &matches) const {
+    matches.clear();
+    vector<string>::const_iterator it = std::lower_bound(m_entries.begin(),
+                                                         m_entries.end(),
+                                                         prefix);
+    for (; it != m_entries.end() && isPrefix(prefix, *it); ++it)
+        matches.push_back(*it);
+
+    // entries are sorted already, so a stable sort keeps alphabetic order
+    // among equally used commands
+    if (!m_frequency.empty())
+        std::stable_sort(matches.begin(), matches.end(), CompareFrequency(m_frequency));
+}
+
+void CompletionCache::pathDirs(PathDirs &dirs) {
+    dirs.clear();
+    const char *env = getenv("PATH");
+    if (env == 0)
+        return;
+
+    string path(env);
+    for (size_t l = 0, r = 0; r <= path.size(); ++r) {
+        if (r != path.size() && path[r] != ':')
+            continue;
+        if (r - l > 1) {
+            PathDir dir;
+            dir.name = path.substr(l, r - l);
+            if (*dir.name.rbegin() != '/')
+                dir.name += '/';
+            struct stat buf;
+            dir.mtime = stat(dir.name.c_str(), &buf) == 0 ? buf.st_mtime : (time_t)-1;
+            dirs.push_back(dir);
+        }
+        l = r + 1;
+    }
+}
+
+void CompletionCache::scan(const PathDirs &dirs, vector<string> &entries) {
+    entries.clear();
+    FbTk::Directory dir;
+    for (size_t i = 0; i < dirs.size(); ++i) {
+        if (dirs[i].mtime == (time_t)-1 || !dir.open(dirs[i].name.c_str()))
+            continue;
+        struct dirent *ent;
+        while ((ent = dir.read()) != 0) {
+            if (ent->d_name[0] == '.' &&
+                (ent->d_name[1] == 0 || (ent->d_name[1] == '.' && ent->d_name[2] == 0)))
+                continue;
+#ifdef _DIRENT_HAVE_D_TYPE
+            if (ent->d_type == DT_DIR)
+                continue;
+#endif // _DIRENT_HAVE_D_TYPE
+            // one stat answers both "directory?" and "executable?"
+            struct stat buf;
+            string file = dirs[i].name + ent->d_name;
+            if (stat(file.c_str(), &buf) != 0 || S_ISDIR(buf.st_mode))
+                continue;
+            if (buf.st_mode & (S_IXUSR | S_IXGRP | S_IXOTH))
+                entries.push_back(ent->d_name);
+        }
+        dir.close();
+    }
+    std::sort(entries.begin(), entries.end());
+    entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+}
+
+bool CompletionCache::read(const PathDirs &dirs, vector<string> &entries) const {
+    ifstream infile(m_cache_file.c_str());
+    if (!infile)
+        return false;
+
+    string line;
+    if (!getline(infile, line) || line != CACHE_MAGIC)
+        return false;
+
+    // header: one "<mtime> <dir>" line per $PATH entry, then an empty line
+    for (size_t i = 0; i < dirs.size(); ++i) {
+        if (!getline(infile, line))
+            return false;
+        size_t space = line.find(' ');
+        if (space == string::npos ||
+            strtol(line.c_str(), 0, 10) != static_cast<long>(dirs[i].mtime) ||
+            line.compare(space + 1, string::npos, dirs[i].name) != 0)
+            return false;
+    }
+    if (!getline(infile, line) || !line.empty())
+        return false;
+
+    entries.clear();
+    while (getline(infile, line)) {
+        if (!line.empty())
+            entries.push_back(line);
+    }
+    // the file might have been edited by hand
+    if (!std::is_sorted(entries.begin(), entries.end()))
+        std::sort(entries.begin(), entries.end());
+    return true;
+}
+
+bool CompletionCache::write(const PathDirs &dirs, const vector<string> &entries) const {
+    // write to a private file and rename it, so a concurrently running
+    // fbrun never reads a half written cache
+    char pid[32];
+    snprintf(pid, sizeof(pid), ".%ld", static_cast<long>(getpid()));
+    string tmp_file = m_cache_file + pid;
+
+    ofstream outfile(tmp_file.c_str());
+    if (!outfile)
+        return false;
+
+    outfile << CACHE_MAGIC << '\n';
+    for (size_t i = 0; i < dirs.size(); ++i)
+        outfile << static_cast<long>(dirs[i].mtime) << ' ' << dirs[i].name << '\n';
+    outfile << '\n';
+    for (size_t i = 0; i < entries.size(); ++i)
+        outfile << entries[i] << '\n';
+    outfile.close();
+
+    if (!outfile || rename(tmp_file.c_str(), m_cache_file.c_str()) != 0) {
+        unlink(tmp_file.c_str());
+        return false;
+    }
+    return true;
+}
+
+void CompletionCache::update(vector<string> &entries) const {
+    PathDirs dirs;
+    pathDirs(dirs);
+    if (m_cache_file.empty()) {
+        scan(dirs, entries);
+        return;
+    }
+    if (read(dirs, entries))
+        return;
+
+    scan(dirs, entries);
+    write(dirs, entries);
+}
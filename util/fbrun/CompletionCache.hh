@@ -0,0 +1,82 @@
+// CompletionCache.hh
+// Copyright (c) 2026 Fluxbox Team (fluxgen at fluxbox dot org)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+
+#ifndef COMPLETIONCACHE_HH
+#define COMPLETIONCACHE_HH
+
+#include <sys/types.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+   Sorted index of the executables in $PATH.
+
+   The index is kept on disk and is considered valid as long as $PATH
+   lists the same directories with the same modification times. Validating
+   or rebuilding the file happens in a child process started by prepare(),
+   so by the time the user presses Tab the index is usually just read back.
+*/
+class CompletionCache {
+public:
+    CompletionCache();
+    ~CompletionCache();
+
+    /// validate (and rebuild if needed) the cache file in the background
+    void prepare(const std::string &cache_file);
+    /// make sure the index is loaded, waits for prepare() if still running
+    void load();
+    /// use these entries instead of $PATH executables
+    void setEntries(const std::vector<std::string> &entries);
+    /// rank matches by how often they start a command in history
+    void setHistory(const std::vector<std::string> &history);
+
+    /**
+       Fills matches with all entries starting with prefix, most frequently
+       used first and alphabetically otherwise.
+    */
+    void find(const std::string &prefix, std::vector<std::string> &matches) const;
+
+    bool loaded() const { return m_loaded; }
+    bool empty() const { return m_entries.empty(); }
+
+private:
+    struct PathDir {
+        std::string name;
+        time_t mtime;
+    };
+    typedef std::vector<PathDir> PathDirs;
+
+    static void pathDirs(PathDirs &dirs);
+    static void scan(const PathDirs &dirs, std::vector<std::string> &entries);
+    bool read(const PathDirs &dirs, std::vector<std::string> &entries) const;
+    bool write(const PathDirs &dirs, const std::vector<std::string> &entries) const;
+    void update(std::vector<std::string> &entries) const;
+
+    std::string m_cache_file;
+    pid_t m_builder; ///< child process preparing the cache file
+    bool m_loaded;
+    std::vector<std::string> m_entries; ///< sorted, unique
+    std::map<std::string, unsigned int> m_frequency;
+};
+
+#endif // COMPLETIONCACHE_HH
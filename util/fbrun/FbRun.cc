@@ -36,6 +36,7 @@
 #include <X11/keysym.h>
 #include <X11/Xutil.h>
 #include <X11/cursorfont.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include <iostream>
@@ -209,6 +210,7 @@ bool FbRun::loadHistory(const char *filename) {
     }
     // set no current histor to display
     m_current_history_item = m_history.size();
+    m_apps.setHistory(m_history);
     // set history file
     m_history_file = filename;
     return true;
@@ -221,15 +223,22 @@ bool FbRun::loadCompletion(const char *filename) {
     if (!infile)
         return false;
 
-    m_apps.clear();
+    std::vector<std::string> apps;
     string line;
     while (getline(infile, line)) {
         if (!line.empty()) // don't add empty lines
-            m_apps.push_back(line);
+            apps.push_back(line);
     }
+    // an empty file means: complete $PATH executables
+    if (!apps.empty())
+        m_apps.setEntries(apps);
     return true;
 }
 
+void FbRun::prepareCompletion(const char *cache_file) {
+    m_apps.prepare(cache_file ? cache_file : "");
+}
+
 
 bool FbRun::loadFont(const string &fontname) {
     if (!m_font.load(fontname.c_str()))
@@ -472,63 +481,62 @@ void FbRun::tabCompleteApps() {
         }
         prefix = prefix.substr(0, split+1);
         if (prefix != m_last_completion_path) {
-            m_files.clear();
             m_current_files_item = -1;
             m_last_completion_path = prefix;
 
-            FbTk::Directory dir;
             std::string path = prefix;
             if (path.at(0) == '~')
                 path.replace(0,1,getenv("HOME"));
-            dir.open(path.c_str());
-            int n = dir.entries();
-            while (--n > -1) {
-                std::string entry = dir.readFilename();
-                if (entry == "." || entry == "..")
-                    continue;
-                // escape special characters
-                std::string needle(" !\"$&'()*,:;<=>?@[\\]^`{|}");
-                std::size_t pos = 0;
-                while ((pos = entry.find_first_of(needle, pos)) != std::string::npos) {
-                    entry.insert(pos, "\\");
-                    pos += 2;
+
+            // directories are only read again when they have changed
+            struct stat buf;
+            time_t mtime = stat(path.c_str(), &buf) == 0 ? buf.st_mtime : (time_t)-1;
+            DirListing &listing = m_dir_listings[path];
+            if (mtime == (time_t)-1 || listing.mtime != mtime || listing.entries.empty()) {
+                listing.mtime = mtime;
+                listing.entries.clear();
+
+                FbTk::Directory dir;
+                dir.open(path.c_str());
+                struct dirent *ent;
+                while (mtime != (time_t)-1 && (ent = dir.read()) != 0) {
+                    std::string entry = ent->d_name;
+                    if (entry == "." || entry == "..")
+                        continue;
+                    bool is_dir;
+#ifdef _DIRENT_HAVE_D_TYPE
+                    if (ent->d_type != DT_UNKNOWN && ent->d_type != DT_LNK)
+                        is_dir = ent->d_type == DT_DIR;
+                    else
+#endif // _DIRENT_HAVE_D_TYPE
+                        is_dir = FbTk::FileUtil::isDirectory(std::string(path + entry).c_str());
+                    // escape special characters
+                    std::string needle(" !\"$&'()*,:;<=>?@[\\]^`{|}");
+                    std::size_t pos = 0;
+                    while ((pos = entry.find_first_of(needle, pos)) != std::string::npos) {
+                        entry.insert(pos, "\\");
+                        pos += 2;
+                    }
+                    listing.entries.push_back(is_dir ? entry + "/" : entry);
                 }
-                if (FbTk::FileUtil::isDirectory(std::string(path + entry).c_str()))
-                    m_files.push_back(prefix + entry + "/");
-                else
-                    m_files.push_back(prefix + entry);
+                dir.close();
+                sort(listing.entries.begin(), listing.entries.end());
             }
-            dir.close();
-            sort(m_files.begin(), m_files.end());
+
+            m_files.clear();
+            for (size_t i = 0; i < listing.entries.size(); ++i)
+                m_files.push_back(prefix + listing.entries[i]);
         }
         tabComplete(m_files, m_current_files_item);
     } else {
-        static bool first_run = true;
-        if (first_run && m_apps.empty()) {
-            first_run = false;
-            std::string path = getenv("PATH");
-            FbTk::Directory dir;
-            for (unsigned int l = 0, r = 0; r <= path.size(); ++r) {
-                if ((r == path.size() || path.at(r) == ':') && r - l > 1) {
-                    dir.open(path.substr(l, r - l).c_str());
-                    prefix = dir.name() + (*dir.name().rbegin() == '/' ? "" : "/");
-                    int n = dir.entries();
-                    while (--n > -1) {
-                        std::string entry = dir.readFilename();
-                        std::string file = prefix + entry;
-                        if (FbTk::FileUtil::isExecutable(file.c_str()) &&
-                                     !FbTk::FileUtil::isDirectory(file.c_str())) {
-                            m_apps.push_back(entry);
-                        }
-                    }
-                    dir.close();
-                    l = r + 1;
-                }
-            }
-            sort(m_apps.begin(), m_apps.end());
-            unique(m_apps.begin(), m_apps.end());
+        m_apps.load();
+        if (prefix != m_last_apps_prefix || m_app_matches.empty()) {
+            m_last_apps_prefix = prefix;
+            m_apps.find(prefix, m_app_matches);
+            // start before the first item, so the best ranked one comes first
+            m_current_apps_item = m_app_matches.size() - 1;
         }
-        tabComplete(m_apps, m_current_apps_item);
+        tabComplete(m_app_matches, m_current_apps_item);
     }
 }
 
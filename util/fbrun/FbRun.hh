@@ -29,6 +29,9 @@
 #include "FbTk/GContext.hh"
 #include "FbTk/FbPixmap.hh"
 
+#include "CompletionCache.hh"
+
+#include <map>
 #include <string>
 #include <vector>
 
@@ -60,6 +63,11 @@ public:
     */
     bool loadHistory(const char *filename);
     bool loadCompletion(const char *filename);
+    /**
+       starts validating the $PATH completion cache in the background,
+       unless completion data was loaded from a file already
+    */
+    void prepareCompletion(const char *cache_file);
     /**
        @name events
     */
@@ -98,12 +106,21 @@ private:
     std::string m_history_file; ///< holds filename for command history file
     int m_current_history_item; ///< holds current position in command history
 
+    struct DirListing {
+        time_t mtime;
+        std::vector<std::string> entries; ///< sorted, directories end with '/'
+    };
+    typedef std::map<std::string, DirListing> DirListings;
+
     std::vector<std::string> m_files;
     int m_current_files_item;
     std::string m_last_completion_path; ///< last prefix we completed on
+    DirListings m_dir_listings; ///< directories read for completion so far
 
-    std::vector<std::string> m_apps;
-    int m_current_apps_item; ///< holds current position in apps-history
+    CompletionCache m_apps; ///< index of completable commands
+    std::vector<std::string> m_app_matches; ///< ranked matches for m_last_apps_prefix
+    std::string m_last_apps_prefix;
+    int m_current_apps_item; ///< holds current position in m_app_matches
 
     size_t m_completion_pos;
     bool m_autocomplete;
@@ -92,6 +92,7 @@ int main(int argc, char **argv) {
     string display_name; // name of the display connection
     string history_file("~/.fluxbox/fbrun_history"); // command history file
     string completion_file; // command history file
+    string cache_file("~/.fluxbox/fbrun_cache"); // index of $PATH executables
     // parse arguments
     for (int i=1; i<argc; i++) {
         string arg = argv[i];
@@ -184,6 +185,10 @@ int main(int argc, char **argv) {
                 cerr<<"FbRun Warning: Failed to load completion file: "<<expanded_filename<<endl;
         }
 
+        // build the $PATH index while the user is still typing
+        expanded_filename = FbTk::StringUtil::expandFilename(cache_file);
+        fbrun.prepareCompletion(expanded_filename.c_str());
+
         fbrun.setPadding(padding);
         fbrun.setTitle(title);
         fbrun.setText(text);